@@ -0,0 +1,70 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <enc28j60/crc/crc32.hpp>
+#include <enc28j60/filter/hash_table.hpp>
+#include "harness.hpp"
+
+/**
+ * CRC-32 kernels over frame sized buffers. The "bytes" counter is
+ * the frame size, so ns/bytes compares the kernels.
+ */
+
+using namespace enc28j60;
+using bench::do_not_optimize;
+using bench::opaque;
+using bench::state;
+
+namespace {
+
+using kernel = std::uint32_t (*)(std::uint32_t, const std::uint8_t *, std::size_t);
+
+template<std::size_t Size>
+constexpr std::array<std::uint8_t, Size> frame() {
+    std::array<std::uint8_t, Size> data{};
+    for (std::size_t i = 0; i < Size; ++i) {
+        data[i] = static_cast<std::uint8_t>(i * 7 + 1);
+    }
+    return data;
+}
+
+template<kernel Kernel, std::size_t Size>
+void run(state &s) {
+    static constexpr auto data = frame<Size>();
+    std::uint32_t crc = crc::initial;
+    while (s.keep_running()) {
+        crc = Kernel(opaque(crc), data.data(), data.size());
+    }
+    do_not_optimize(crc);
+    s.counter("bytes", double(Size) * s.iterations());
+}
+
+std::uint32_t bytewise(std::uint32_t crc, const std::uint8_t *data, std::size_t size) {
+    return crc::detail::update_bytewise(crc, data, size);
+}
+
+void hash_index(state &s) {
+    while (s.keep_running()) {
+        const filter::mac_address address{0x01, 0x00, 0x5e, 0x00, 0x00,
+                                          opaque(std::uint8_t{0xfb})};
+        do_not_optimize(filter::hash_index(address));
+    }
+}
+
+const bench::registrar registrars[] = {
+    {"crc/bytewise/64", run<bytewise, 64>},
+    {"crc/bytewise/512", run<bytewise, 512>},
+    {"crc/bytewise/1518", run<bytewise, 1518>},
+    {"crc/slicing8/64", run<crc::detail::update_slicing8, 64>},
+    {"crc/slicing8/512", run<crc::detail::update_slicing8, 512>},
+    {"crc/slicing8/1518", run<crc::detail::update_slicing8, 1518>},
+#ifdef ENC28J60_CRC_X86
+    {"crc/pclmul/64", run<crc::detail::update_pclmul, 64>},
+    {"crc/pclmul/512", run<crc::detail::update_pclmul, 512>},
+    {"crc/pclmul/1518", run<crc::detail::update_pclmul, 1518>},
+#endif
+    {"crc/dispatched/1518", run<crc::update, 1518>},
+    {"crc/hash_index", hash_index},
+};
+
+}
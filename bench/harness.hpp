@@ -0,0 +1,128 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace enc28j60::bench {
+
+/**
+ * Keeps the compiler from discarding `value` or the computation
+ * producing it.
+ */
+template<typename T>
+inline void do_not_optimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * Returns `value` in a way the compiler can't see through, so a
+ * benchmark can't be folded into a constant by accident.
+ */
+template<typename T>
+inline T opaque(T value) {
+    asm volatile("" : "+r"(value) : : "memory");
+    return value;
+}
+
+class state {
+public:
+    explicit state(std::uint64_t iterations) : iterations_(iterations) {}
+    
+    bool keep_running() {
+        if (remaining_ == iterations_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+        if (remaining_--) {
+            return true;
+        }
+        elapsed_ = std::chrono::steady_clock::now() - start_;
+        return false;
+    }
+    
+    std::uint64_t iterations() const {
+        return iterations_;
+    }
+    
+    /**
+     * Reports `total` over all iterations, written as the value per
+     * iteration.
+     */
+    void counter(const char *name, double total) {
+        counters_.emplace_back(name, total / iterations_);
+    }
+    
+    std::chrono::nanoseconds elapsed() const {
+        return elapsed_;
+    }
+    
+    const std::vector<std::pair<std::string, double>> &counters() const {
+        return counters_;
+    }
+    
+private:
+    std::uint64_t iterations_;
+    std::uint64_t remaining_ = iterations_;
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::nanoseconds elapsed_{};
+    std::vector<std::pair<std::string, double>> counters_;
+};
+
+using function = void (*)(state &);
+
+struct benchmark {
+    const char *name;
+    function run;
+};
+
+inline std::vector<benchmark> &registry() {
+    static std::vector<benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct registrar {
+    registrar(const char *name, function run) {
+        registry().push_back({name, run});
+    }
+};
+
+/**
+ * Runs every benchmark whose name contains `filter` and prints one
+ * JSON object per line: name, iterations, ns per iteration and the
+ * counters. Iterations double until a run takes `min_time`.
+ */
+inline int run_all(const char *filter,
+                   std::chrono::nanoseconds min_time = std::chrono::milliseconds(200)) {
+    for (const benchmark &b : registry()) {
+        if (filter && !std::strstr(b.name, filter)) {
+            continue;
+        }
+        
+        for (std::uint64_t iterations = 1;; iterations *= 2) {
+            state s(iterations);
+            b.run(s);
+            if (s.elapsed() < min_time && iterations < (1ull << 40)) {
+                continue;
+            }
+            
+            std::printf("{\"name\": \"%s\", \"iterations\": %llu, \"ns\": %.3f",
+                        b.name, static_cast<unsigned long long>(iterations),
+                        double(s.elapsed().count()) / iterations);
+            for (const auto &[name, value] : s.counters()) {
+                std::printf(", \"%s\": %.3f", name.c_str(), value);
+            }
+            std::printf("}\n");
+            break;
+        }
+    }
+    return 0;
+}
+
+}
+
+#define ENC28J60_BENCHMARK(fn) \
+    static const ::enc28j60::bench::registrar fn##_registrar(#fn, fn)
@@ -0,0 +1,12 @@
+#include "harness.hpp"
+
+/**
+ * Usage: enc28j60_bench [filter]
+ *
+ * Runs the benchmarks whose name contains `filter` and prints one
+ * JSON object per benchmark and line. Built from all sources in
+ * this directory with -O2 and include/ on the include path.
+ */
+int main(int argc, char **argv) {
+    return enc28j60::bench::run_all(argc > 1 ? argv[1] : nullptr);
+}
@@ -0,0 +1,168 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <enc28j60/device.hpp>
+#include <enc28j60/init/layout.hpp>
+#include <enc28j60/init/script.hpp>
+#include <enc28j60/phy/address.hpp>
+#include <enc28j60/phy/engine.hpp>
+#include <enc28j60/rx/ring.hpp>
+#include <enc28j60/sim/chip.hpp>
+#include <enc28j60/tx/queue.hpp>
+#include "harness.hpp"
+
+/**
+ * Driver operations against the simulator. Wall time mostly shows
+ * host overhead, the counters show what the operation costs on a
+ * real bus: transactions, bytes and bank switches per iteration.
+ */
+
+using namespace enc28j60;
+using bench::do_not_optimize;
+using bench::state;
+
+namespace {
+
+constexpr init::layout plan = init::plan<0x1400, 2>();
+
+constexpr init::configuration layout = [] {
+    init::configuration config = plan.apply(init::configuration());
+    config.receive_filter = eth::receive_filter(0);
+    return config;
+}();
+
+constexpr auto image = init::script<init::script_size(layout)>(layout);
+
+/**
+ * Frame sizes on the wire, the FCS is appended by the device.
+ */
+constexpr std::size_t fcs_size = 4;
+
+struct fixture {
+    sim::chip chip;
+    device dev{chip};
+    rx::ring ring{dev, plan.rx_start, plan.rx_end};
+    tx::queue<plan.slots> queue{dev, plan.tx_start, plan.slot_size};
+    
+    sim::chip::statistics start{};
+    std::uint64_t switches = 0;
+    
+    fixture() {
+        init::play(dev, image);
+        ring.init();
+        queue.init();
+        mark();
+    }
+    
+    /**
+     * Starts counting, setup traffic is not reported.
+     */
+    void mark() {
+        start = chip.stats();
+        switches = dev.stats().bank_switches.load();
+    }
+    
+    void report(state &s) const {
+        s.counter("transactions", double(chip.stats().transactions - start.transactions));
+        s.counter("spi_bytes", double(chip.stats().bytes - start.bytes));
+        s.counter("bank_switches", double(dev.stats().bank_switches.load() - switches));
+    }
+};
+
+void init(state &s) {
+    fixture f;
+    while (s.keep_running()) {
+        init::play(f.dev, image);
+    }
+    f.report(s);
+}
+
+template<std::size_t Size>
+void send(state &s) {
+    fixture f;
+    std::array<std::uint8_t, Size - fcs_size> frame{};
+    frame.fill(0x5a);
+    f.mark();
+    
+    while (s.keep_running()) {
+        while (!f.queue.free_slots()) {
+            f.queue.poll();
+        }
+        do_not_optimize(f.queue.send(frame.data(), frame.size()));
+    }
+    f.report(s);
+}
+
+template<std::size_t Size>
+void receive(state &s) {
+    fixture f;
+    std::array<std::uint8_t, Size - fcs_size> frame{};
+    frame.fill(0x5a);
+    std::array<std::uint8_t, 1536> buffer{};
+    f.mark();
+    
+    while (s.keep_running()) {
+        f.chip.receive(frame.data(), frame.size());
+        while (f.ring.pending()) {
+            do_not_optimize(f.ring.receive(buffer.data(), buffer.size()));
+        }
+    }
+    f.report(s);
+}
+
+/**
+ * Eight frames per iteration, read back to back with one buffer
+ * read.
+ */
+template<std::size_t Size>
+void receive_burst(state &s) {
+    constexpr std::size_t frames = 8;
+    
+    fixture f;
+    std::array<std::uint8_t, Size - fcs_size> frame{};
+    frame.fill(0x5a);
+    std::array<std::uint8_t, 8192> buffer{};
+    std::array<rx::packet, frames> packets{};
+    f.mark();
+    
+    while (s.keep_running()) {
+        for (std::size_t i = 0; i < frames; ++i) {
+            f.chip.receive(frame.data(), frame.size());
+        }
+        for (std::size_t pending = f.ring.pending(); pending;) {
+            pending -= f.ring.receive_burst(buffer.data(), buffer.size(),
+                                            packets.data(), pending);
+        }
+        do_not_optimize(packets);
+    }
+    f.report(s);
+}
+
+void phy_read(state &s) {
+    fixture f;
+    phy::engine engine(f.dev);
+    f.mark();
+    
+    while (s.keep_running()) {
+        engine.start_read(phy::address::phstat2);
+        while (!engine.poll()) {
+        }
+        do_not_optimize(engine.result());
+    }
+    f.report(s);
+}
+
+const bench::registrar registrars[] = {
+    {"operations/init", init},
+    {"operations/send/64", send<64>},
+    {"operations/send/512", send<512>},
+    {"operations/send/1518", send<1518>},
+    {"operations/receive/64", receive<64>},
+    {"operations/receive/512", receive<512>},
+    {"operations/receive/1518", receive<1518>},
+    {"operations/receive_burst/64x8", receive_burst<64>},
+    {"operations/receive_burst/512x8", receive_burst<512>},
+    {"operations/phy_read", phy_read},
+};
+
+}
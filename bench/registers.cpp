@@ -0,0 +1,244 @@
+#include <cstdint>
+#include <enc28j60/mac/register.hpp>
+#include <enc28j60/phy/register.hpp>
+#include "harness.hpp"
+
+/**
+ * Building a register from constants should cost nothing, the
+ * "constant" benchmarks have to match "baseline". The other ones
+ * use values hidden from the compiler and show the cost of the
+ * bit operations left at run time.
+ */
+
+using namespace enc28j60;
+using bench::do_not_optimize;
+using bench::opaque;
+using bench::state;
+
+namespace {
+
+template<typename Register>
+constexpr typename Register::native_type pattern() {
+    return static_cast<typename Register::native_type>(0xa5a5);
+}
+
+template<typename Register, Register (*Build)(bool)>
+void encode_constant(state &s) {
+    while (s.keep_running()) {
+        do_not_optimize(Build(true).data());
+    }
+}
+
+template<typename Register, Register (*Build)(bool)>
+void encode(state &s) {
+    while (s.keep_running()) {
+        do_not_optimize(Build(opaque(true)).data());
+    }
+}
+
+template<typename Register, unsigned (*Decode)(const Register &)>
+void decode(state &s) {
+    while (s.keep_running()) {
+        do_not_optimize(Decode(Register(opaque(pattern<Register>()))));
+    }
+}
+
+void baseline(state &s) {
+    while (s.keep_running()) {
+        do_not_optimize(opaque(0));
+    }
+}
+
+constexpr mac::control_register_1 build_macon1(bool on) {
+    return mac::control_register_1()
+        .loopback(!on)
+        .transmit_pause_frames(on)
+        .receive_pause_frames(on)
+        .pass_all(!on)
+        .receive(on);
+}
+
+unsigned decode_macon1(const mac::control_register_1 &r) {
+    return r.loopback() + r.transmit_pause_frames() + r.receive_pause_frames() +
+           r.pass_all() + r.receive();
+}
+
+constexpr mac::control_register_2 build_macon2(bool on) {
+    return mac::control_register_2()
+        .reset(on)
+        .reset_random_number_generator(!on)
+        .reset_receive_logic(on)
+        .reset_receive_function(!on)
+        .reset_transmit_logic(on)
+        .reset_transmit_function(!on);
+}
+
+unsigned decode_macon2(const mac::control_register_2 &r) {
+    return r.reset() + r.reset_random_number_generator() +
+           r.reset_receive_logic() + r.reset_receive_function() +
+           r.reset_transmit_logic() + r.reset_transmit_function();
+}
+
+constexpr mac::control_register_3 build_macon3(bool on) {
+    return mac::control_register_3()
+        .transmit_crc(on)
+        .proprietary_header(!on)
+        .huge_frame(!on)
+        .check_frame_length(on)
+        .full_duplex(on)
+        .auto_padding(on ? mac::control_register_3::pad_60_vlan_64
+                         : mac::control_register_3::no_pad);
+}
+
+unsigned decode_macon3(const mac::control_register_3 &r) {
+    return r.transmit_crc() + r.proprietary_header() + r.huge_frame() +
+           r.check_frame_length() + r.full_duplex() + r.auto_padding();
+}
+
+constexpr mac::control_register_4 build_macon4(bool on) {
+    return mac::control_register_4()
+        .defer_transmission(on)
+        .no_backoff_on_back_pressure(!on)
+        .no_backoff(!on)
+        .long_preamble_enforcement(on)
+        .pure_preamble_enforcement(on);
+}
+
+unsigned decode_macon4(const mac::control_register_4 &r) {
+    return r.defer_transmission() + r.no_backoff_on_back_pressure() +
+           r.no_backoff() + r.long_preamble_enforcement() +
+           r.pure_preamble_enforcement();
+}
+
+constexpr mac::btb_inter_package_gap build_mabbipg(bool on) {
+    return mac::btb_inter_package_gap().delay(on ? 0x15 : 0x12);
+}
+
+unsigned decode_mabbipg(const mac::btb_inter_package_gap &r) {
+    return r.delay();
+}
+
+constexpr mac::phy_support build_maphsup(bool on) {
+    return mac::phy_support().interface_reset(on).rmii_reset(!on);
+}
+
+unsigned decode_maphsup(const mac::phy_support &r) {
+    return r.interface_reset() + r.rmii_reset();
+}
+
+constexpr phy::control_register_1 build_phcon1(bool on) {
+    return phy::control_register_1()
+        .software_reset(!on)
+        .loopback(!on)
+        .power_down(!on)
+        .full_duplex(on);
+}
+
+unsigned decode_phcon1(const phy::control_register_1 &r) {
+    return r.software_reset() + r.loopback() + r.power_down() + r.full_duplex();
+}
+
+constexpr phy::control_register_2 build_phcon2(bool on) {
+    return phy::control_register_2()
+        .force_linkup(on)
+        .disable_twisted_pair_transmitter(!on)
+        .jabber_correction(on)
+        .disable_half_duplex_loopback(on);
+}
+
+unsigned decode_phcon2(const phy::control_register_2 &r) {
+    return r.force_linkup() + r.disable_twisted_pair_transmitter() +
+           r.jabber_correction() + r.disable_half_duplex_loopback();
+}
+
+constexpr phy::interrupt_enable build_phie(bool on) {
+    return phy::interrupt_enable().link_change(on).global(on);
+}
+
+unsigned decode_phie(const phy::interrupt_enable &r) {
+    return r.link_change() + r.global();
+}
+
+unsigned decode_phir(const phy::interrupt_request &r) {
+    return r.link_change() + r.global();
+}
+
+constexpr phy::led_control build_phlcon(bool on) {
+    return phy::led_control()
+        .led_a(on ? phy::led_control::display_link_status
+                  : phy::led_control::off)
+        .led_b(on ? phy::led_control::display_rx_tx_activity
+                  : phy::led_control::off)
+        .pulse_stretch_time(on ? phy::led_control::ms_73
+                               : phy::led_control::ms_40)
+        .pulse_stretching(on);
+}
+
+unsigned decode_phlcon(const phy::led_control &r) {
+    return r.led_a() + r.led_b() + r.pulse_stretch_time() + r.pulse_stretching();
+}
+
+unsigned decode_phstat1(const phy::status_1 &r) {
+    return r.full_duplex_capable() + r.half_duplex_capable() +
+           r.link_up_latched() + r.jabber_latched();
+}
+
+unsigned decode_phstat2(const phy::status_2 &r) {
+    return r.transmitting() + r.receiving() + r.collision_occured() +
+           r.link_up() + r.full_duplex() + r.reversed_polarity();
+}
+
+// The builders have to fold to constants, so their results and a
+// set/get round trip can be checked at compile time. The values are
+// the datasheet encodings.
+static_assert(build_macon1(true).data() == 0x0d);
+static_assert(build_macon2(true).data() == 0x8a);
+static_assert(build_macon3(true).data() == 0xb3);
+static_assert(build_macon3(false).auto_padding() ==
+              mac::control_register_3::no_pad);
+static_assert(build_macon4(true).data() == 0x43);
+static_assert(build_mabbipg(true).delay() == 0x15);
+static_assert(build_maphsup(true).data() == 0x90);
+static_assert(build_phcon1(true).full_duplex() &&
+              !build_phcon1(true).power_down());
+static_assert(build_phcon2(false).data() == 0x2000);
+static_assert(build_phie(true).data() == 0x12);
+static_assert(build_phlcon(true).data() == 0x3476);
+static_assert(build_phlcon(true).led_b() ==
+              phy::led_control::display_rx_tx_activity);
+static_assert(build_phlcon(false).data() == 0x3990);
+
+void decode_phid(state &s) {
+    while (s.keep_running()) {
+        const phy::device_id id(phy::device_id_1(opaque<std::uint16_t>(0x0083)),
+                                phy::device_id_2(opaque<std::uint16_t>(0x1400)));
+        do_not_optimize(id.identifier() + id.part_number() + id.revision_level());
+    }
+}
+
+#define ENC28J60_REGISTER_BENCHMARKS(group, name, type)                           \
+    {group "/" #name "/encode_constant", encode_constant<type, build_##name>},    \
+    {group "/" #name "/encode", encode<type, build_##name>},                      \
+    {group "/" #name "/decode", decode<type, decode_##name>}
+
+const bench::registrar registrars[] = {
+    {"registers/baseline", baseline},
+    ENC28J60_REGISTER_BENCHMARKS("mac", macon1, mac::control_register_1),
+    ENC28J60_REGISTER_BENCHMARKS("mac", macon2, mac::control_register_2),
+    ENC28J60_REGISTER_BENCHMARKS("mac", macon3, mac::control_register_3),
+    ENC28J60_REGISTER_BENCHMARKS("mac", macon4, mac::control_register_4),
+    ENC28J60_REGISTER_BENCHMARKS("mac", mabbipg, mac::btb_inter_package_gap),
+    ENC28J60_REGISTER_BENCHMARKS("mac", maphsup, mac::phy_support),
+    ENC28J60_REGISTER_BENCHMARKS("phy", phcon1, phy::control_register_1),
+    ENC28J60_REGISTER_BENCHMARKS("phy", phcon2, phy::control_register_2),
+    ENC28J60_REGISTER_BENCHMARKS("phy", phie, phy::interrupt_enable),
+    ENC28J60_REGISTER_BENCHMARKS("phy", phlcon, phy::led_control),
+    {"phy/phir/decode", decode<phy::interrupt_request, decode_phir>},
+    {"phy/phstat1/decode", decode<phy::status_1, decode_phstat1>},
+    {"phy/phstat2/decode", decode<phy::status_2, decode_phstat2>},
+    {"phy/phid/decode", decode_phid},
+};
+
+#undef ENC28J60_REGISTER_BENCHMARKS
+
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include <poll.h>
+#include <enc28j60/async/task.hpp>
+
+namespace enc28j60::async {
+
+/**
+ * Something the executor waits for, typically one device behind
+ * its interrupt line.
+ */
+class source {
+public:
+    virtual ~source() = default;
+    
+    /**
+     * Descriptor becoming readable when wake() has work to do, -1
+     * if there is none.
+     */
+    virtual int fd() const = 0;
+    
+    virtual void wake() = 0;
+    
+    /**
+     * Makes progress on pending operations and schedules the
+     * coroutines waiting for the completed ones.
+     */
+    virtual void process() = 0;
+    
+    /**
+     * True if process() has to be called again without waiting
+     * for the descriptor, e.g. while a PHY access runs.
+     */
+    virtual bool busy() const = 0;
+};
+
+/**
+ * Single threaded executor running coroutines on top of any number
+ * of sources. While no coroutine is ready it blocks in poll() on
+ * the descriptors of all sources, or only checks them while a
+ * source is busy.
+ */
+class executor {
+public:
+    executor() = default;
+    
+    executor(const executor &) = delete;
+    executor &operator=(const executor &) = delete;
+    
+    /**
+     * Starts `t` as a top level task owned by the executor.
+     */
+    void spawn(task<> t) {
+        const std::coroutine_handle<> handle = t.handle();
+        tasks_.push_back(std::move(t));
+        schedule(handle);
+    }
+    
+    void schedule(std::coroutine_handle<> handle) {
+        ready_.push_back(handle);
+    }
+    
+    void attach(source &s) {
+        sources_.push_back(&s);
+    }
+    
+    void detach(source &s) {
+        sources_.erase(std::remove(sources_.begin(), sources_.end(), &s),
+                       sources_.end());
+    }
+    
+    /**
+     * Runs until all top level tasks have finished. Returns false
+     * if tasks are left which nothing can wake up anymore.
+     */
+    bool run() {
+        for (;;) {
+            while (!ready_.empty()) {
+                const std::coroutine_handle<> handle = ready_.front();
+                ready_.pop_front();
+                handle.resume();
+            }
+            
+            tasks_.erase(std::remove_if(tasks_.begin(), tasks_.end(),
+                                        [](const task<> &t) { return t.done(); }),
+                         tasks_.end());
+            if (tasks_.empty()) {
+                return true;
+            }
+            
+            bool busy = false;
+            for (source *s : sources_) {
+                s->process();
+                busy = busy || s->busy();
+            }
+            
+            if (ready_.empty() && !wait(busy ? 0 : -1)) {
+                return false;
+            }
+        }
+    }
+    
+private:
+    bool wait(int timeout_ms) {
+        descriptors_.clear();
+        waiting_.clear();
+        for (source *s : sources_) {
+            if (s->fd() >= 0) {
+                descriptors_.push_back({s->fd(), POLLIN | POLLPRI, 0});
+                waiting_.push_back(s);
+            }
+        }
+        
+        if (descriptors_.empty()) {
+            return timeout_ms == 0;
+        }
+        
+        const int count = ::poll(descriptors_.data(), descriptors_.size(),
+                                 timeout_ms);
+        if (count < 0) {
+            return errno == EINTR;
+        }
+        
+        for (std::size_t i = 0; i < descriptors_.size(); ++i) {
+            if (descriptors_[i].revents) {
+                waiting_[i]->wake();
+            }
+        }
+        return true;
+    }
+    
+    std::vector<task<>> tasks_;
+    std::deque<std::coroutine_handle<>> ready_;
+    std::vector<source *> sources_;
+    
+    std::vector<pollfd> descriptors_;
+    std::vector<source *> waiting_;
+};
+
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <span>
+#include <enc28j60/async/executor.hpp>
+#include <enc28j60/detail/register_address.hpp>
+#include <enc28j60/device.hpp>
+#include <enc28j60/eth/register.hpp>
+#include <enc28j60/irq/dispatcher.hpp>
+#include <enc28j60/irq/line.hpp>
+#include <enc28j60/phy/engine.hpp>
+#include <enc28j60/rx/ring.hpp>
+#include <enc28j60/tx/queue.hpp>
+
+namespace enc28j60::async {
+
+/**
+ * Awaitable receive, send and PHY operations on one device.
+ *
+ * The interface is a source of the executor: it services the
+ * interrupt line when it becomes readable and completes waiting
+ * operations from the EIR flags, so idle devices cost nothing but
+ * a descriptor in poll(). Only PHY accesses, which raise no
+ * interrupt, are polled while they run.
+ *
+ * Operations of one kind complete in the order they were started.
+ * Buffers passed to receive() and send() have to stay valid until
+ * the operation completes, which holds for locals of the awaiting
+ * coroutine.
+ */
+template<std::size_t Slots>
+class interface : public source {
+public:
+    class receive_operation;
+    class send_operation;
+    class phy_operation;
+    
+    template<typename Register>
+    class phy_read_operation;
+    
+    interface(executor &exec, device &dev, irq::line &line, rx::ring &ring,
+              tx::queue<Slots> &queue)
+        : executor_(exec), line_(line), ring_(ring), queue_(queue),
+          dispatcher_(dev, line), phy_(dev) {
+        dispatcher_.on_receive([this] { receive_check_ = true; });
+        dispatcher_.on_transmit([this] { transmit_done_ = true; });
+        dispatcher_.on_transmit_error([this] { transmit_done_ = true; });
+        dispatcher_.enable(eth::interrupt_enable(0)
+                               .receive(true)
+                               .transmit(true)
+                               .transmit_error(true));
+        service();
+        executor_.attach(*this);
+    }
+    
+    interface(const interface &) = delete;
+    interface &operator=(const interface &) = delete;
+    
+    ~interface() {
+        executor_.detach(*this);
+        dispatcher_.disable();
+    }
+    
+    /**
+     * Waits for the next frame and reads it into `buffer`. Resumes
+     * with the result of rx::ring::receive().
+     */
+    receive_operation receive(std::span<std::uint8_t> buffer) {
+        return receive_operation(*this, buffer);
+    }
+    
+    /**
+     * Waits for a free transmit slot, loads `frame` and resumes
+     * with the outcome once it has left the queue, std::nullopt if
+     * it does not fit into a slot.
+     */
+    send_operation send(std::span<const std::uint8_t> frame) {
+        return send_operation(*this, frame);
+    }
+    
+    template<typename Register>
+    phy_read_operation<Register> read_phy() {
+        return phy_read_operation<Register>(*this, Register::address);
+    }
+    
+    template<typename Register>
+    phy_operation write_phy(const Register &reg) {
+        return phy_operation(*this, Register::address, reg.data(), true);
+    }
+    
+    irq::dispatcher &dispatcher() {
+        return dispatcher_;
+    }
+    
+    int fd() const override {
+        return line_.fd();
+    }
+    
+    void wake() override {
+        line_.acknowledge();
+        service();
+    }
+    
+    void process() override {
+        receive_frames();
+        load_frames();
+        advance_phy();
+    }
+    
+    bool busy() const override {
+        return !phy_waiting_.empty();
+    }
+    
+    class receive_operation {
+    public:
+        bool await_ready() const noexcept {
+            return false;
+        }
+        
+        void await_suspend(std::coroutine_handle<> handle) {
+            handle_ = handle;
+            interface_.receive_waiting_.push_back(this);
+            interface_.receive_check_ = true;
+        }
+        
+        std::optional<rx::packet> await_resume() {
+            return result_;
+        }
+        
+    private:
+        friend class interface;
+        
+        receive_operation(interface &i, std::span<std::uint8_t> buffer)
+            : interface_(i), buffer_(buffer) {}
+        
+        interface &interface_;
+        std::span<std::uint8_t> buffer_;
+        std::optional<rx::packet> result_;
+        std::coroutine_handle<> handle_;
+    };
+    
+    class send_operation {
+    public:
+        bool await_ready() const noexcept {
+            return false;
+        }
+        
+        void await_suspend(std::coroutine_handle<> handle) {
+            handle_ = handle;
+            interface_.send_waiting_.push_back(this);
+        }
+        
+        std::optional<tx::outcome> await_resume() {
+            return result_;
+        }
+        
+    private:
+        friend class interface;
+        
+        send_operation(interface &i, std::span<const std::uint8_t> frame)
+            : interface_(i), frame_(frame) {}
+        
+        interface &interface_;
+        std::span<const std::uint8_t> frame_;
+        std::optional<tx::outcome> result_;
+        std::coroutine_handle<> handle_;
+    };
+    
+    class phy_operation {
+    public:
+        bool await_ready() const noexcept {
+            return false;
+        }
+        
+        void await_suspend(std::coroutine_handle<> handle) {
+            handle_ = handle;
+            interface_.phy_waiting_.push_back(this);
+        }
+        
+        void await_resume() {}
+        
+    protected:
+        friend class interface;
+        
+        phy_operation(interface &i, register_address reg, std::uint16_t value,
+                      bool write)
+            : interface_(i), register_(reg), value_(value), write_(write) {}
+        
+        interface &interface_;
+        register_address register_;
+        std::uint16_t value_;
+        bool write_;
+        bool started_ = false;
+        std::coroutine_handle<> handle_;
+    };
+    
+    template<typename Register>
+    class phy_read_operation : public phy_operation {
+    public:
+        Register await_resume() {
+            return Register(this->value_);
+        }
+        
+    private:
+        friend class interface;
+        
+        phy_read_operation(interface &i, register_address reg)
+            : phy_operation(i, reg, 0, false) {}
+    };
+    
+private:
+    /**
+     * Runs one dispatcher pass. An aborted transmission sets TXIF
+     * and TXERIF together, so the queue is completed once per pass
+     * rather than once per flag.
+     */
+    void service() {
+        dispatcher_.service();
+        if (transmit_done_) {
+            transmit_done_ = false;
+            complete();
+        }
+    }
+    
+    /**
+     * Hands pending frames to the waiting receivers. EPKTCNT is
+     * only read after PKTIF or a new receiver, a frame left over
+     * keeps PKTIF set and raises the line again.
+     */
+    void receive_frames() {
+        if (!receive_check_ || receive_waiting_.empty()) {
+            return;
+        }
+        receive_check_ = false;
+        
+        for (std::uint8_t count = ring_.pending();
+             count && !receive_waiting_.empty(); --count) {
+            receive_operation *operation = receive_waiting_.front();
+            receive_waiting_.pop_front();
+            operation->result_ = ring_.receive(operation->buffer_.data(),
+                                               operation->buffer_.size());
+            executor_.schedule(operation->handle_);
+        }
+    }
+    
+    void load_frames() {
+        while (!send_waiting_.empty() && queue_.free_slots()) {
+            send_operation *operation = send_waiting_.front();
+            send_waiting_.pop_front();
+            if (queue_.send(operation->frame_.data(), operation->frame_.size())) {
+                sending_.push_back(operation);
+            } else {
+                executor_.schedule(operation->handle_);
+            }
+        }
+    }
+    
+    /**
+     * Called after TXIF or TXERIF. A late collision that is retried
+     * completes nothing yet.
+     */
+    void complete() {
+        const std::optional<tx::outcome> result = queue_.complete(false);
+        if (!result || sending_.empty()) {
+            return;
+        }
+        
+        send_operation *operation = sending_.front();
+        sending_.pop_front();
+        operation->result_ = result;
+        executor_.schedule(operation->handle_);
+    }
+    
+    void advance_phy() {
+        if (phy_waiting_.empty()) {
+            return;
+        }
+        
+        phy_operation *operation = phy_waiting_.front();
+        if (!operation->started_) {
+            operation->started_ =
+                operation->write_ ?
+                    phy_.start_write(operation->register_, operation->value_) :
+                    phy_.start_read(operation->register_);
+            return;
+        }
+        if (!phy_.poll()) {
+            return;
+        }
+        
+        if (!operation->write_) {
+            operation->value_ = phy_.result();
+        }
+        phy_waiting_.pop_front();
+        executor_.schedule(operation->handle_);
+    }
+    
+    executor &executor_;
+    irq::line &line_;
+    rx::ring &ring_;
+    tx::queue<Slots> &queue_;
+    irq::dispatcher dispatcher_;
+    phy::engine phy_;
+    
+    bool receive_check_ = true;
+    bool transmit_done_ = false;
+    std::deque<receive_operation *> receive_waiting_;
+    std::deque<send_operation *> send_waiting_;
+    std::deque<send_operation *> sending_;
+    std::deque<phy_operation *> phy_waiting_;
+};
+
+template<std::size_t Slots>
+interface(executor &, device &, irq::line &, rx::ring &, tx::queue<Slots> &)
+    -> interface<Slots>;
+
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#if !defined(__cpp_impl_coroutine)
+#error "enc28j60/async requires C++20 coroutines"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace enc28j60::async {
+
+template<typename T = void>
+class task;
+
+namespace detail {
+
+class promise_base {
+public:
+    struct final_awaiter {
+        bool await_ready() noexcept {
+            return false;
+        }
+        
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<Promise> handle) noexcept {
+            return handle.promise().continuation_;
+        }
+        
+        void await_resume() noexcept {}
+    };
+    
+    std::suspend_always initial_suspend() noexcept {
+        return {};
+    }
+    
+    final_awaiter final_suspend() noexcept {
+        return {};
+    }
+    
+    /**
+     * The library does not use exceptions.
+     */
+    void unhandled_exception() {
+        std::terminate();
+    }
+    
+    void continuation(std::coroutine_handle<> handle) {
+        continuation_ = handle;
+    }
+    
+private:
+    std::coroutine_handle<> continuation_ = std::noop_coroutine();
+};
+
+template<typename T>
+class promise : public promise_base {
+public:
+    task<T> get_return_object();
+    
+    void return_value(T value) {
+        value_ = std::move(value);
+    }
+    
+    T &&result() {
+        return std::move(*value_);
+    }
+    
+private:
+    std::optional<T> value_;
+};
+
+template<>
+class promise<void> : public promise_base {
+public:
+    task<void> get_return_object();
+    
+    void return_void() {}
+    
+    void result() {}
+};
+
+}
+
+/**
+ * Lazily started coroutine. Awaiting it runs it to completion and
+ * resumes the awaiting coroutine afterwards, top level tasks are
+ * run by an executor.
+ */
+template<typename T>
+class [[nodiscard]] task {
+public:
+    using promise_type = detail::promise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
+    
+    explicit task(handle_type handle) : handle_(handle) {}
+    
+    task(task &&other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    
+    task &operator=(task &&other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    
+    ~task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+    
+    bool done() const {
+        return !handle_ || handle_.done();
+    }
+    
+    handle_type handle() const {
+        return handle_;
+    }
+    
+    auto operator co_await() const noexcept {
+        struct awaiter {
+            handle_type handle;
+            
+            bool await_ready() noexcept {
+                return !handle || handle.done();
+            }
+            
+            std::coroutine_handle<> await_suspend(
+                    std::coroutine_handle<> continuation) noexcept {
+                handle.promise().continuation(continuation);
+                return handle;
+            }
+            
+            decltype(auto) await_resume() {
+                return handle.promise().result();
+            }
+        };
+        return awaiter{handle_};
+    }
+    
+private:
+    handle_type handle_;
+};
+
+namespace detail {
+
+template<typename T>
+task<T> promise<T>::get_return_object() {
+    return task<T>(std::coroutine_handle<promise<T>>::from_promise(*this));
+}
+
+inline task<void> promise<void>::get_return_object() {
+    return task<void>(std::coroutine_handle<promise<void>>::from_promise(*this));
+}
+
+}
+
+}
@@ -0,0 +1,324 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <poll.h>
+#include <enc28j60/device.hpp>
+#include <enc28j60/eth/register.hpp>
+#include <enc28j60/irq/dispatcher.hpp>
+#include <enc28j60/irq/line.hpp>
+#include <enc28j60/rx/ring.hpp>
+#include <enc28j60/spi/bus.hpp>
+#include <enc28j60/statistics.hpp>
+
+namespace enc28j60::bus {
+
+/**
+ * Scheduling parameters of a manager.
+ */
+struct manager_options {
+    /**
+     * Jobs a device may run per turn.
+     */
+    std::size_t quantum = 4;
+    
+    /**
+     * Frames drained per turn below the urgent mark.
+     */
+    std::size_t receive_budget = 4;
+    
+    /**
+     * EPKTCNT from which a device is drained completely at the
+     * start of the next round.
+     */
+    std::uint8_t urgent_pending = 8;
+    
+    /**
+     * Size of the buffer frames are received into.
+     */
+    std::size_t max_frame_length = 1518;
+};
+
+/**
+ * Runs several devices sharing one SPI controller from a single
+ * thread.
+ *
+ * Every device keeps its own bank and read pointer shadows, so
+ * interleaving their transactions costs no extra bank switches and
+ * needs no lock. Work is queued per device as jobs and the devices
+ * take turns: each turn runs a bounded number of jobs and receive
+ * drains of one device inside a single batch, starting with a
+ * different device every round. Devices whose EPKTCNT reached the
+ * urgent mark are drained completely before anything else, so a
+ * busy neighbour can't make a ring overflow.
+ *
+ * With several SPI controllers every controller gets its own
+ * manager and worker thread, the managers share nothing. Other
+ * threads hand work to a manager through post().
+ */
+class manager {
+public:
+    using job = std::function<void(device &)>;
+    using receive_handler =
+        std::function<void(std::size_t index, const rx::packet &packet)>;
+    
+    /**
+     * Scheduling counters of the manager, apart from the per device
+     * statistics. Written by the worker thread, readable from any
+     * thread.
+     */
+    struct round_statistics {
+        statistics::counter rounds;
+        statistics::counter turns;
+        statistics::counter jobs;
+        statistics::counter frames;
+        
+        /**
+         * Devices drained completely because they reached the
+         * urgent mark.
+         */
+        statistics::counter urgent_drains;
+    };
+    
+    manager() : manager(manager_options()) {}
+    
+    explicit manager(const manager_options &options)
+        : options_(options), buffer_(options.max_frame_length) {}
+    
+    manager(const manager &) = delete;
+    manager &operator=(const manager &) = delete;
+    
+    /**
+     * Adds the device behind `bus`, which must not be used outside
+     * the manager from now on. Returns the index of the device.
+     */
+    std::size_t add(spi::bus &bus, irq::line &line) {
+        const std::size_t index = members_.size();
+        members_.push_back(std::make_unique<member>(index, bus, line));
+        return index;
+    }
+    
+    std::size_t size() const {
+        return members_.size();
+    }
+    
+    /**
+     * The device, to set it up before run_once() is called or from
+     * within a job.
+     */
+    enc28j60::device &device(std::size_t index) {
+        return members_[index]->dev;
+    }
+    
+    irq::dispatcher &dispatcher(std::size_t index) {
+        return members_[index]->dispatcher;
+    }
+    
+    /**
+     * Drains `ring` whenever the device raises PKTIF, the frames are
+     * passed to the receive handler. Enables the receive interrupt.
+     */
+    void receive(std::size_t index, rx::ring &ring) {
+        member &m = *members_[index];
+        m.ring = &ring;
+        m.dispatcher.on_receive([&m] { m.check = true; });
+        m.dispatcher.enable(m.dispatcher.sources().receive(true));
+        m.check = true;
+    }
+    
+    void on_receive(receive_handler handler) {
+        receive_ = std::move(handler);
+    }
+    
+    /**
+     * Queues a job for the device, only from the thread running the
+     * manager.
+     */
+    void submit(std::size_t index, job j) {
+        members_[index]->jobs.push_back(std::move(j));
+    }
+    
+    /**
+     * Queues a job for the device from any thread and wakes the
+     * manager.
+     */
+    void post(std::size_t index, job j) {
+        {
+            const std::lock_guard<std::mutex> lock(inbox_mutex_);
+            inbox_.emplace_back(index, std::move(j));
+        }
+        wake_.trigger();
+    }
+    
+    /**
+     * Services the interrupt lines and runs one round over all
+     * devices. Blocks up to `timeout_ms` if there is nothing to do,
+     * a negative value waits forever. Returns false if the round
+     * found no work.
+     */
+    bool run_once(int timeout_ms = -1) {
+        collect();
+        wait(busy() ? 0 : timeout_ms);
+        collect();
+        stats_.rounds.add();
+        
+        bool worked = false;
+        for (auto &m : members_) {
+            refresh(*m);
+            if (m->pending >= options_.urgent_pending) {
+                const spi::batch batch(m->dev.bus());
+                drain(*m, m->pending);
+                stats_.urgent_drains.add();
+                worked = true;
+            }
+        }
+        
+        const std::size_t count = members_.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            member &m = *members_[(cursor_ + i) % count];
+            refresh(m);
+            if (!m.pending && m.jobs.empty()) {
+                continue;
+            }
+            
+            const spi::batch batch(m.dev.bus());
+            drain(m, options_.receive_budget);
+            for (std::size_t n = 0; n < options_.quantum && !m.jobs.empty(); ++n) {
+                const job j = std::move(m.jobs.front());
+                m.jobs.pop_front();
+                j(m.dev);
+                stats_.jobs.add();
+            }
+            stats_.turns.add();
+            worked = true;
+        }
+        
+        if (count) {
+            cursor_ = (cursor_ + 1) % count;
+        }
+        return worked;
+    }
+    
+    const round_statistics &stats() const {
+        return stats_;
+    }
+    
+private:
+    struct member {
+        member(std::size_t position, spi::bus &bus, irq::line &interrupt)
+            : index(position), dev(bus), line(interrupt),
+              dispatcher(dev, interrupt) {}
+        
+        std::size_t index;
+        enc28j60::device dev;
+        irq::line &line;
+        irq::dispatcher dispatcher;
+        rx::ring *ring = nullptr;
+        std::deque<job> jobs;
+        
+        /**
+         * Frames known to be in the ring from the last EPKTCNT read.
+         */
+        std::uint8_t pending = 0;
+        
+        /**
+         * EPKTCNT has to be read, after PKTIF or once the known
+         * frames are drained, since PKTIF staying set raises no new
+         * edge.
+         */
+        bool check = false;
+    };
+    
+    bool busy() const {
+        for (const auto &m : members_) {
+            if (m->pending || m->check || !m->jobs.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void collect() {
+        const std::lock_guard<std::mutex> lock(inbox_mutex_);
+        for (auto &[index, j] : inbox_) {
+            members_[index]->jobs.push_back(std::move(j));
+        }
+        inbox_.clear();
+    }
+    
+    void wait(int timeout_ms) {
+        descriptors_.clear();
+        descriptors_.push_back({wake_.fd(), POLLIN, 0});
+        for (const auto &m : members_) {
+            descriptors_.push_back({m->line.fd(), POLLIN | POLLPRI, 0});
+        }
+        
+        if (::poll(descriptors_.data(), descriptors_.size(), timeout_ms) <= 0) {
+            return;
+        }
+        
+        if (descriptors_[0].revents) {
+            wake_.acknowledge();
+        }
+        for (std::size_t i = 1; i < descriptors_.size(); ++i) {
+            if (descriptors_[i].revents) {
+                member &m = *members_[i - 1];
+                m.line.acknowledge();
+                const spi::batch batch(m.dev.bus());
+                m.dispatcher.service();
+            }
+        }
+    }
+    
+    void refresh(member &m) {
+        if (m.check && m.ring) {
+            m.check = false;
+            m.pending = m.ring->pending();
+        }
+    }
+    
+    void drain(member &m, std::size_t budget) {
+        const bool known = m.pending;
+        for (; m.pending && budget; --m.pending, --budget) {
+            const std::optional<rx::packet> packet =
+                m.ring->receive(buffer_.data(), buffer_.size());
+            if (!packet) {
+                // corrupted ring, the owner has to reinitialise it
+                m.pending = 0;
+                return;
+            }
+            
+            stats_.frames.add();
+            if (receive_) {
+                receive_(m.index, *packet);
+            }
+        }
+        
+        if (known && !m.pending) {
+            m.check = true;
+        }
+    }
+    
+    manager_options options_;
+    std::vector<std::unique_ptr<member>> members_;
+    std::size_t cursor_ = 0;
+    std::vector<std::uint8_t> buffer_;
+    receive_handler receive_;
+    
+    std::mutex inbox_mutex_;
+    std::vector<std::pair<std::size_t, job>> inbox_;
+    irq::pipe_line wake_;
+    
+    std::vector<pollfd> descriptors_;
+    round_statistics stats_;
+};
+
+}
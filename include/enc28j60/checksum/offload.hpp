@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <enc28j60/checksum/software.hpp>
+#include <enc28j60/device.hpp>
+#include <enc28j60/dma/engine.hpp>
+#include <enc28j60/eth/address.hpp>
+
+namespace enc28j60::checksum {
+
+/**
+ * Cost model deciding whether a region of the buffer memory is
+ * checksummed by the DMA engine or read over SPI and checksummed
+ * in software.
+ */
+struct policy {
+    std::uint32_t spi_frequency = 20000000;
+    
+    /**
+     * Fixed cost of a single SPI transaction apart from its bytes,
+     * chip select handling and driver overhead.
+     */
+    std::uint32_t transaction_ns = 2000;
+    
+    /**
+     * Time the DMA engine needs per byte.
+     */
+    std::uint32_t dma_ns_per_byte = 80;
+    
+    enum class method {
+        hardware,
+        software
+    };
+    
+    /**
+     * Chooses the cheaper method for `size` bytes. `in_host_memory`
+     * tells if the data is already available without an SPI read.
+     */
+    constexpr method choose(std::size_t size, bool in_host_memory) const {
+        if (in_host_memory) {
+            return method::software;
+        }
+        
+        // EDMAST, EDMAND, start, one poll and EDMACS
+        const std::uint64_t dma_transactions = 8;
+        const std::uint64_t hardware =
+            dma_transactions * (transaction_ns + wire_ns(2)) +
+            size * dma_ns_per_byte;
+            
+        // ERDPT and the buffer read
+        const std::uint64_t read_transactions = 3;
+        const std::uint64_t software =
+            read_transactions * transaction_ns + wire_ns(4 + 1 + size);
+            
+        return hardware < software ? method::hardware : method::software;
+    }
+    
+    constexpr std::uint64_t wire_ns(std::size_t bytes) const {
+        return bytes * 8ull * 1000000000ull / spi_frequency;
+    }
+};
+
+/**
+ * Checksums regions of the buffer memory with the method the
+ * policy prefers.
+ */
+class offload {
+public:
+    offload(device &dev, dma::engine &engine, const checksum::policy &policy = {})
+        : device_(dev), engine_(engine), policy_(policy) {}
+        
+    /**
+     * Internet checksum of `size` bytes starting at `start`. The
+     * software path reads the region into `scratch`, which has to
+     * hold `size` bytes. Passing nullptr forces the DMA engine.
+     *
+     * Returns std::nullopt if the DMA engine did not finish, see
+     * dma::engine::checksum().
+     */
+    std::optional<std::uint16_t> region(std::uint16_t start, std::uint16_t size,
+                         std::uint8_t *scratch = nullptr) {
+        if (size == 0) {
+            return 0xffff;
+        }
+        
+        if (!scratch ||
+            policy_.choose(size, false) == policy::method::hardware) {
+            return engine_.checksum(start, last(start, size));
+        }
+        
+        device_.read_pointer(start);
+        device_.read_buffer(scratch, size);
+        return compute(scratch, size);
+    }
+    
+    /**
+     * Limits of the receive ring, regions starting inside it wrap
+     * from `end` to `start`.
+     */
+    void receive_ring(std::uint16_t start, std::uint16_t end) {
+        rx_start_ = start;
+        rx_end_ = end;
+    }
+    
+    const checksum::policy &policy() const {
+        return policy_;
+    }
+    
+private:
+    std::uint16_t last(std::uint16_t start, std::uint16_t size) const {
+        std::uint32_t end = start + size - 1u;
+        if (start >= rx_start_ && start <= rx_end_ && end > rx_end_) {
+            end -= rx_end_ - rx_start_ + 1u;
+        }
+        return static_cast<std::uint16_t>(end);
+    }
+    
+    device &device_;
+    dma::engine &engine_;
+    checksum::policy policy_;
+    std::uint16_t rx_start_ = 1;
+    std::uint16_t rx_end_ = 0;
+};
+
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ENC28J60_CHECKSUM_X86 1
+#include <immintrin.h>
+#endif
+
+namespace enc28j60::checksum {
+
+namespace detail {
+
+/**
+ * Two little endian 16 bit words at `data` as one 32 bit value,
+ * whatever the host byte order. Compilers turn it into a single
+ * load on little endian hosts.
+ */
+inline std::uint32_t load_words(const std::uint8_t *data) {
+    return static_cast<std::uint32_t>(data[0]) |
+           static_cast<std::uint32_t>(data[1]) << 8 |
+           static_cast<std::uint32_t>(data[2]) << 16 |
+           static_cast<std::uint32_t>(data[3]) << 24;
+}
+
+/**
+ * All kernels add up little endian 16 bit words, also on big endian
+ * hosts, the vector ones only exist for x86. The one's complement
+ * sum is byte order independent, so swapping the folded result yields
+ * the network byte order sum.
+ */
+inline std::uint64_t sum_scalar(const std::uint8_t *data, std::size_t size) {
+    std::uint64_t sum = 0;
+    for (; size >= 8; data += 8, size -= 8) {
+        sum += load_words(data);
+        sum += load_words(data + 4);
+    }
+    for (; size >= 2; data += 2, size -= 2) {
+        sum += data[0] | data[1] << 8;
+    }
+    if (size) {
+        sum += data[0];
+    }
+    return sum;
+}
+
+#ifdef ENC28J60_CHECKSUM_X86
+
+__attribute__((target("sse2")))
+inline std::uint64_t sum_sse2(const std::uint8_t *data, std::size_t size) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i accumulator = zero;
+    
+    for (; size >= 16; data += 16, size -= 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+        
+        // widen the 16 bit words to 32 bit, then to 64 bit lanes
+        const __m128i words = _mm_add_epi32(_mm_unpacklo_epi16(v, zero),
+                                            _mm_unpackhi_epi16(v, zero));
+        accumulator = _mm_add_epi64(
+            accumulator, _mm_add_epi64(_mm_unpacklo_epi32(words, zero),
+                                       _mm_unpackhi_epi32(words, zero)));
+    }
+    
+    std::uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), accumulator);
+    return lanes[0] + lanes[1] + sum_scalar(data, size);
+}
+
+__attribute__((target("avx2")))
+inline std::uint64_t sum_avx2(const std::uint8_t *data, std::size_t size) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i accumulator = zero;
+    
+    for (; size >= 32; data += 32, size -= 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+        
+        // lane order does not matter for a sum
+        const __m256i words = _mm256_add_epi32(_mm256_unpacklo_epi16(v, zero),
+                                               _mm256_unpackhi_epi16(v, zero));
+        accumulator = _mm256_add_epi64(
+            accumulator, _mm256_add_epi64(_mm256_unpacklo_epi32(words, zero),
+                                          _mm256_unpackhi_epi32(words, zero)));
+    }
+    
+    std::uint64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), accumulator);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_sse2(data, size);
+}
+
+#endif
+
+using kernel = std::uint64_t (*)(const std::uint8_t *, std::size_t);
+
+inline kernel select_kernel() {
+#ifdef ENC28J60_CHECKSUM_X86
+    if (__builtin_cpu_supports("avx2")) {
+        return sum_avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return sum_sse2;
+    }
+#endif
+    return sum_scalar;
+}
+
+}
+
+/**
+ * Folds a one's complement sum to 16 bit.
+ */
+constexpr std::uint16_t fold(std::uint64_t sum) {
+    while (sum >> 16) {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return static_cast<std::uint16_t>(sum);
+}
+
+/**
+ * One's complement sum of `data` in network byte order, added to
+ * `initial`. Only the last of several consecutive blocks may have
+ * an odd size.
+ */
+inline std::uint16_t sum(const std::uint8_t *data, std::size_t size,
+                         std::uint16_t initial = 0) {
+    static const detail::kernel kernel = detail::select_kernel();
+    
+    const std::uint16_t little = fold(kernel(data, size));
+    const std::uint16_t big = static_cast<std::uint16_t>(little << 8 | little >> 8);
+    return fold(static_cast<std::uint32_t>(big) + initial);
+}
+
+/**
+ * Internet checksum (RFC 1071) of `data` as stored in a header.
+ */
+inline std::uint16_t compute(const std::uint8_t *data, std::size_t size,
+                             std::uint16_t initial = 0) {
+    return static_cast<std::uint16_t>(~sum(data, size, initial));
+}
+
+}
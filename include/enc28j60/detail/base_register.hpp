@@ -1,6 +1,7 @@
 #pragma once
 
 #include <type_traits>
+#include <enc28j60/detail/field.hpp>
 
 namespace enc28j60 {
     
@@ -11,29 +12,36 @@ class base_register {
 public:
     using native_type = NativeType;
     
+    template<native_type Mask, typename T = bool>
+    using field = enc28j60::field<native_type, Mask, T>;
+    
+    template<native_type Mask, native_type Value>
+    using reserved = enc28j60::reserved<native_type, Mask, Value>;
+    
     constexpr base_register() = default;
     constexpr base_register(native_type data) : data_(data) {}
     
     
     constexpr void data(native_type data) { data_ = data; }
     
-    constexpr unsigned char data() const { return data_; }
+    constexpr native_type data() const { return data_; }
     
 protected:
-    constexpr void set_bits(native_type bits, bool value = true) { 
-        if (value) {
-            data_ |= bits;
-        } else {
-            data_ &= ~bits;
-        }
+    template<typename Field>
+    constexpr void set(typename Field::value_type value) {
+        data_ = static_cast<native_type>((data_ & ~Field::mask) |
+                                         Field::pack(value));
     }
     
-    constexpr native_type get_bits(native_type bits) const {
-        return data_ & bits;
+    template<typename Field>
+    constexpr typename Field::value_type get() const {
+        return Field::unpack(data_);
     }
     
-    constexpr bool check_bits(native_type bits) const {
-        return bits & data_;
+    template<typename Reserved>
+    constexpr void init() {
+        data_ = static_cast<native_type>((data_ & ~Reserved::mask) |
+                                         Reserved::value);
     }
 
 private:
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <type_traits>
+
+namespace enc28j60 {
+
+namespace detail {
+
+template<typename NativeType>
+constexpr unsigned lowest_bit(NativeType mask) {
+    unsigned shift = 0;
+    while (!((mask >> shift) & 1)) {
+        ++shift;
+    }
+    return shift;
+}
+
+template<typename NativeType>
+constexpr unsigned bit_count(NativeType mask) {
+    unsigned count = 0;
+    for (; mask; mask &= mask - 1) {
+        ++count;
+    }
+    return count;
+}
+
+}
+
+/**
+ * Describes a contiguous group of bits inside a register of
+ * NativeType. The shift is derived from the mask, so packing and
+ * unpacking reduce to a shift and a mask.
+ */
+template<typename NativeType, NativeType Mask, typename T = bool>
+struct field {
+    static_assert(std::is_integral_v<NativeType>,
+                  "NativeType requirements not met.");
+    static_assert(Mask != 0, "Empty field.");
+    
+    using native_type = NativeType;
+    using value_type = T;
+    
+    static constexpr native_type mask = Mask;
+    static constexpr unsigned shift = detail::lowest_bit(Mask);
+    
+    static_assert(((Mask >> shift) & ((Mask >> shift) + 1)) == 0,
+                  "Field bits have to be contiguous.");
+    
+    static constexpr native_type pack(value_type value) {
+        return static_cast<native_type>(
+            static_cast<native_type>(value) << shift) & mask;
+    }
+    
+    static constexpr value_type unpack(native_type data) {
+        return static_cast<value_type>((data & mask) >> shift);
+    }
+};
+
+/**
+ * Bits with a fixed value the device requires to be written.
+ */
+template<typename NativeType, NativeType Mask, NativeType Value>
+struct reserved {
+    static_assert((Value & ~Mask) == 0, "Reserved value outside of mask.");
+    
+    using native_type = NativeType;
+    
+    static constexpr native_type mask = Mask;
+    static constexpr native_type value = Value;
+};
+
+/**
+ * True if no two of the given fields or reserved bits overlap.
+ */
+template<typename... Fields>
+constexpr bool disjoint() {
+    using native_type = std::common_type_t<typename Fields::native_type...>;
+    
+    const native_type all = (native_type{0} | ... | Fields::mask);
+    const unsigned sum = (0u + ... + detail::bit_count(Fields::mask));
+    return detail::bit_count(all) == sum;
+}
+
+}
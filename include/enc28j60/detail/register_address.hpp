@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+
+namespace enc28j60 {
+
+enum class register_bank : std::uint8_t {
+    bank_0 = 0,
+    bank_1 = 1,
+    bank_2 = 2,
+    bank_3 = 3,
+    
+    /**
+     * EIE, EIR, ESTAT, ECON2 and ECON1 are mapped into
+     * every bank and never require a bank switch.
+     */
+    common
+};
+
+enum class register_kind : std::uint8_t {
+    /**
+     * ETH control register. Supports the bit field set
+     * and bit field clear commands.
+     */
+    eth,
+    
+    /**
+     * MAC register. Reads shift out a dummy byte before
+     * the register contents.
+     */
+    mac,
+    
+    /**
+     * MII register. Reads shift out a dummy byte before
+     * the register contents.
+     */
+    mii,
+    
+    /**
+     * PHY register. Not directly addressable, accessed
+     * indirectly through MIREGADR, MICMD and MISTAT.
+     */
+    phy
+};
+
+struct register_address {
+    std::uint8_t address;
+    register_bank bank;
+    register_kind kind;
+    
+    constexpr bool dummy_byte() const {
+        return kind == register_kind::mac || kind == register_kind::mii;
+    }
+    
+    constexpr bool bit_field_operations() const {
+        return kind == register_kind::eth;
+    }
+    
+    /**
+     * Returns the address of the upper half of a low/high
+     * register pair like ERDPTL/ERDPTH.
+     */
+    constexpr register_address high() const {
+        return offset(1);
+    }
+    
+    /**
+     * Returns the address `n` registers further in the same bank,
+     * like EHT3 for EHT0.
+     */
+    constexpr register_address offset(std::uint8_t n) const {
+        return {static_cast<std::uint8_t>(address + n), bank, kind};
+    }
+};
+
+constexpr bool operator==(register_address lhs, register_address rhs) {
+    return lhs.address == rhs.address && lhs.bank == rhs.bank &&
+           lhs.kind == rhs.kind;
+}
+
+constexpr bool operator!=(register_address lhs, register_address rhs) {
+    return !(lhs == rhs);
+}
+
+}
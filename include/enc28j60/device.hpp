@@ -0,0 +1,230 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <enc28j60/detail/register_address.hpp>
+#include <enc28j60/eth/address.hpp>
+#include <enc28j60/eth/register.hpp>
+#include <enc28j60/spi/bus.hpp>
+#include <enc28j60/spi/transport.hpp>
+#include <enc28j60/statistics.hpp>
+
+namespace enc28j60 {
+
+/**
+ * Register level access to a single ENC28J60.
+ *
+ * Keeps a shadow copy of ECON1.BSEL and only switches banks if a
+ * banked register outside the selected bank is accessed. The
+ * common registers EIE, EIR, ESTAT, ECON2 and ECON1 never cause a
+ * bank switch. ERDPT is tracked the same way, so consecutive
+ * buffer reads don't have to set it again.
+ *
+ * Counts every transaction in the statistics block shared by the
+ * driver components using the device.
+ */
+class device {
+public:
+    explicit device(spi::bus &bus) : transport_(bus) {}
+    
+    spi::transport &transport() {
+        return transport_;
+    }
+    
+    spi::bus &bus() {
+        return transport_.bus();
+    }
+    
+    std::uint8_t read(register_address reg) {
+        select(reg.bank);
+        count(reg.dummy_byte() ? 3 : 2);
+        return transport_.read(reg);
+    }
+    
+    void write(register_address reg, std::uint8_t value) {
+        select(reg.bank);
+        count(2);
+        transport_.write(reg, value);
+        
+        if (reg == eth::address::econ1) {
+            bank(eth::control_register_1(value).bank_select());
+        } else if (reg == eth::address::erdptl ||
+                   reg == eth::address::erdpth) {
+            read_pointer_ = invalid_pointer;
+        }
+    }
+    
+    void set_bits(register_address reg, std::uint8_t bits) {
+        select(reg.bank);
+        count(2);
+        transport_.set_bits(reg, bits);
+        
+        if (reg == eth::address::econ1 && bank_valid_) {
+            bank(bank_ | eth::control_register_1(bits).bank_select());
+        }
+    }
+    
+    void clear_bits(register_address reg, std::uint8_t bits) {
+        select(reg.bank);
+        count(2);
+        transport_.clear_bits(reg, bits);
+        
+        if (reg == eth::address::econ1 && bank_valid_) {
+            bank(bank_ & ~eth::control_register_1(bits).bank_select());
+        }
+    }
+    
+    /**
+     * Reads a low/high register pair like ERXWRPTL/ERXWRPTH
+     * given the address of the low register.
+     */
+    std::uint16_t read_pair(register_address low) {
+        const std::uint8_t lower = read(low);
+        return lower | read(low.high()) << 8;
+    }
+    
+    /**
+     * Writes a low/high register pair, low register first.
+     */
+    void write_pair(register_address low, std::uint16_t value) {
+        write(low, static_cast<std::uint8_t>(value));
+        write(low.high(), static_cast<std::uint8_t>(value >> 8));
+    }
+    
+    template<typename Register>
+    Register read() {
+        return Register(read(Register::address));
+    }
+    
+    template<typename Register>
+    void write(const Register &reg) {
+        write(Register::address, reg.data());
+    }
+    
+    /**
+     * Points ERDPT at `address` unless it is known to point there
+     * already.
+     */
+    void read_pointer(std::uint16_t address) {
+        if (read_pointer_ != address) {
+            write_pair(eth::address::erdptl, address);
+            read_pointer_ = address;
+        }
+    }
+    
+    /**
+     * Records where ERDPT points after read_buffer(). Only the
+     * caller can tell, reads inside the receive ring wrap.
+     */
+    void assume_read_pointer(std::uint16_t address) {
+        read_pointer_ = address;
+    }
+    
+    void read_buffer(std::uint8_t *data, std::size_t size,
+                     std::size_t discard = 0) {
+        count(1 + size + discard);
+        transport_.read_buffer(data, size, discard);
+        read_pointer_ = invalid_pointer;
+    }
+    
+    void write_buffer(const std::uint8_t *data, std::size_t size) {
+        count(1 + size);
+        transport_.write_buffer(data, size);
+    }
+    
+    /**
+     * Issues a system reset, which also selects bank 0.
+     */
+    void system_reset() {
+        count(1);
+        transport_.system_reset();
+        bank(0);
+        read_pointer_ = invalid_pointer;
+    }
+    
+    /**
+     * Forgets the shadowed bank, required if ECON1 was
+     * changed without going through this device.
+     */
+    void invalidate_bank() {
+        bank_valid_ = false;
+    }
+    
+    /**
+     * A transaction on the bus failed since the last clear_error(),
+     * see spi::bus::failed().
+     */
+    bool failed() const {
+        return transport_.bus().failed();
+    }
+    
+    /**
+     * Clears the bus error. The shadowed bank and ERDPT are
+     * forgotten, the writes that failed may not have reached the
+     * device.
+     */
+    void clear_error() {
+        transport_.bus().clear_error();
+        bank_valid_ = false;
+        read_pointer_ = invalid_pointer;
+    }
+    
+    statistics &stats() {
+        return stats_;
+    }
+    
+    const statistics &stats() const {
+        return stats_;
+    }
+    
+private:
+    static constexpr std::uint16_t invalid_pointer = 0xffff;
+    
+    void bank(std::uint8_t bank) {
+        bank_ = bank;
+        bank_valid_ = true;
+    }
+    
+    void count(std::size_t bytes) {
+        stats_.spi_transactions.add();
+        stats_.spi_bytes.add(bytes);
+    }
+    
+    void select(register_bank target) {
+        if (target == register_bank::common) {
+            return;
+        }
+        
+        const auto bank = static_cast<std::uint8_t>(target);
+        if (bank_valid_ && bank_ == bank) {
+            stats_.bank_switches_elided.add();
+            return;
+        }
+        
+        // only touch the BSEL bits that actually differ
+        const std::uint8_t current = bank_valid_ ? bank_ : 0x03;
+        const std::uint8_t clear = current & ~bank;
+        const std::uint8_t set = bank & ~(bank_valid_ ? bank_ : 0x00);
+        
+        if (clear) {
+            count(2);
+            transport_.clear_bits(eth::address::econ1, clear);
+        }
+        if (set) {
+            count(2);
+            transport_.set_bits(eth::address::econ1, set);
+        }
+        
+        this->bank(bank);
+        stats_.bank_switches.add();
+    }
+    
+    spi::transport transport_;
+    
+    std::uint8_t bank_ = 0;
+    bool bank_valid_ = false;
+    std::uint16_t read_pointer_ = invalid_pointer;
+    statistics stats_;
+};
+
+}
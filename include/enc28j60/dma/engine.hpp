@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <enc28j60/device.hpp>
+#include <enc28j60/eth/address.hpp>
+#include <enc28j60/eth/register.hpp>
+#include <enc28j60/spi/bus.hpp>
+
+namespace enc28j60::dma {
+
+/**
+ * Drives the on-chip DMA engine.
+ *
+ * Ranges starting inside the receive ring wrap from ERXND to ERXST
+ * like the receive hardware does.
+ */
+class engine {
+public:
+    /**
+     * ECON1 reads spent waiting for an operation before giving up.
+     * At 20 MHz that is over 3 ms, several times what the DMA
+     * engine needs for the whole buffer memory.
+     */
+    static constexpr unsigned max_polls = 4096;
+    
+    explicit engine(device &dev) : device_(dev) {}
+    
+    /**
+     * Starts calculating the internet checksum over the inclusive
+     * range [start, end] of the buffer memory.
+     */
+    void start_checksum(std::uint16_t start, std::uint16_t end) {
+        const spi::batch batch(device_.bus());
+        range(start, end);
+        device_.set_bits(eth::address::econ1,
+                         eth::control_register_1(0)
+                             .checksum(true)
+                             .dma_start(true)
+                             .data());
+        checksum_mode_ = true;
+        busy_ = true;
+    }
+    
+    /**
+     * Starts copying the inclusive range [start, end] of the buffer
+     * memory to `destination`.
+     */
+    void start_copy(std::uint16_t start, std::uint16_t end,
+                    std::uint16_t destination) {
+        const spi::batch batch(device_.bus());
+        range(start, end);
+        device_.write_pair(eth::address::edmadstl, destination);
+        if (checksum_mode_) {
+            device_.clear_bits(eth::address::econ1,
+                               eth::control_register_1(0).checksum(true).data());
+            checksum_mode_ = false;
+        }
+        device_.set_bits(eth::address::econ1,
+                         eth::control_register_1(0).dma_start(true).data());
+        busy_ = true;
+    }
+    
+    /**
+     * Copies a range and waits for completion. Returns false if the
+     * engine is still busy after `max_polls` reads.
+     */
+    bool copy(std::uint16_t start, std::uint16_t end,
+              std::uint16_t destination) {
+        start_copy(start, end, destination);
+        return wait();
+    }
+    
+    /**
+     * Checks ECON1.DMAST once, returns true when the DMA engine
+     * is idle.
+     */
+    bool poll() {
+        if (busy_) {
+            busy_ = eth::control_register_1(
+                device_.read(eth::address::econ1)).dma_start();
+        }
+        return !busy_;
+    }
+    
+    /**
+     * Result of the last checksum operation, ready to be stored in
+     * a header in network byte order.
+     */
+    std::uint16_t checksum() {
+        return device_.read(eth::address::edmacsh) << 8 |
+               device_.read(eth::address::edmacsl);
+    }
+    
+    /**
+     * Calculates a checksum and waits for the result, std::nullopt
+     * if the engine is still busy after `max_polls` reads. poll()
+     * tells when it has finished after all.
+     */
+    std::optional<std::uint16_t> checksum(std::uint16_t start,
+                                          std::uint16_t end) {
+        start_checksum(start, end);
+        if (!wait()) {
+            return std::nullopt;
+        }
+        return checksum();
+    }
+    
+    bool busy() const {
+        return busy_;
+    }
+    
+private:
+    bool wait() {
+        for (unsigned i = 0; i < max_polls; ++i) {
+            if (poll()) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void range(std::uint16_t start, std::uint16_t end) {
+        device_.write_pair(eth::address::edmastl, start);
+        device_.write_pair(eth::address::edmandl, end);
+    }
+    
+    device &device_;
+    bool busy_ = false;
+    
+    /**
+     * ECON1.CSUMEN might be set, assumed until the first copy
+     * cleared it.
+     */
+    bool checksum_mode_ = true;
+};
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <enc28j60/detail/register_address.hpp>
+
+namespace enc28j60::eth::address {
+
+namespace detail {
+
+constexpr register_address make(register_bank bank, std::uint8_t address) {
+    return {address, bank, register_kind::eth};
+}
+
+}
+
+// bank 0
+inline constexpr register_address erdptl = detail::make(register_bank::bank_0, 0x00);
+inline constexpr register_address erdpth = detail::make(register_bank::bank_0, 0x01);
+inline constexpr register_address ewrptl = detail::make(register_bank::bank_0, 0x02);
+inline constexpr register_address ewrpth = detail::make(register_bank::bank_0, 0x03);
+inline constexpr register_address etxstl = detail::make(register_bank::bank_0, 0x04);
+inline constexpr register_address etxsth = detail::make(register_bank::bank_0, 0x05);
+inline constexpr register_address etxndl = detail::make(register_bank::bank_0, 0x06);
+inline constexpr register_address etxndh = detail::make(register_bank::bank_0, 0x07);
+inline constexpr register_address erxstl = detail::make(register_bank::bank_0, 0x08);
+inline constexpr register_address erxsth = detail::make(register_bank::bank_0, 0x09);
+inline constexpr register_address erxndl = detail::make(register_bank::bank_0, 0x0a);
+inline constexpr register_address erxndh = detail::make(register_bank::bank_0, 0x0b);
+inline constexpr register_address erxrdptl = detail::make(register_bank::bank_0, 0x0c);
+inline constexpr register_address erxrdpth = detail::make(register_bank::bank_0, 0x0d);
+inline constexpr register_address erxwrptl = detail::make(register_bank::bank_0, 0x0e);
+inline constexpr register_address erxwrpth = detail::make(register_bank::bank_0, 0x0f);
+inline constexpr register_address edmastl = detail::make(register_bank::bank_0, 0x10);
+inline constexpr register_address edmasth = detail::make(register_bank::bank_0, 0x11);
+inline constexpr register_address edmandl = detail::make(register_bank::bank_0, 0x12);
+inline constexpr register_address edmandh = detail::make(register_bank::bank_0, 0x13);
+inline constexpr register_address edmadstl = detail::make(register_bank::bank_0, 0x14);
+inline constexpr register_address edmadsth = detail::make(register_bank::bank_0, 0x15);
+inline constexpr register_address edmacsl = detail::make(register_bank::bank_0, 0x16);
+inline constexpr register_address edmacsh = detail::make(register_bank::bank_0, 0x17);
+
+// bank 1
+inline constexpr register_address eht0 = detail::make(register_bank::bank_1, 0x00);
+inline constexpr register_address epmm0 = detail::make(register_bank::bank_1, 0x08);
+inline constexpr register_address epmcsl = detail::make(register_bank::bank_1, 0x10);
+inline constexpr register_address epmcsh = detail::make(register_bank::bank_1, 0x11);
+inline constexpr register_address epmol = detail::make(register_bank::bank_1, 0x14);
+inline constexpr register_address epmoh = detail::make(register_bank::bank_1, 0x15);
+inline constexpr register_address erxfcon = detail::make(register_bank::bank_1, 0x18);
+inline constexpr register_address epktcnt = detail::make(register_bank::bank_1, 0x19);
+
+// bank 3
+inline constexpr register_address ebstsd = detail::make(register_bank::bank_3, 0x06);
+inline constexpr register_address ebstcon = detail::make(register_bank::bank_3, 0x07);
+inline constexpr register_address ebstcsl = detail::make(register_bank::bank_3, 0x08);
+inline constexpr register_address ebstcsh = detail::make(register_bank::bank_3, 0x09);
+inline constexpr register_address erevid = detail::make(register_bank::bank_3, 0x12);
+inline constexpr register_address ecocon = detail::make(register_bank::bank_3, 0x15);
+inline constexpr register_address eflocon = detail::make(register_bank::bank_3, 0x17);
+inline constexpr register_address epausl = detail::make(register_bank::bank_3, 0x18);
+inline constexpr register_address epaush = detail::make(register_bank::bank_3, 0x19);
+
+// common to all banks
+inline constexpr register_address eie = detail::make(register_bank::common, 0x1b);
+inline constexpr register_address eir = detail::make(register_bank::common, 0x1c);
+inline constexpr register_address estat = detail::make(register_bank::common, 0x1d);
+inline constexpr register_address econ2 = detail::make(register_bank::common, 0x1e);
+inline constexpr register_address econ1 = detail::make(register_bank::common, 0x1f);
+
+}
@@ -0,0 +1,623 @@
+#pragma once
+
+#include <cstdint>
+#include <enc28j60/detail/base_register.hpp>
+#include <enc28j60/eth/address.hpp>
+
+namespace enc28j60::eth {
+
+class control_register_1 : public base_register<std::uint8_t> {
+    using base = base_register<std::uint8_t>;
+    
+    struct fields {
+        using tx_reset = base::field<0x80>;
+        using rx_reset = base::field<0x40>;
+        using dma_start = base::field<0x20>;
+        using checksum = base::field<0x10>;
+        using tx_request = base::field<0x08>;
+        using rx_enable = base::field<0x04>;
+        using bank_select = base::field<0x02 + 0x01, std::uint8_t>;
+    };
+    
+    static_assert(disjoint<fields::tx_reset, fields::rx_reset,
+                           fields::dma_start, fields::checksum,
+                           fields::tx_request, fields::rx_enable,
+                           fields::bank_select>());
+    
+public:
+    static constexpr register_address address = eth::address::econ1;
+    
+    constexpr control_register_1() {
+        transmit_logic_reset(false);
+        receive_logic_reset(false);
+        dma_start(false);
+        checksum(false);
+        transmit_request(false);
+        receive(false);
+        bank_select(0);
+    }
+    
+    constexpr control_register_1(std::uint8_t data) : base(data) {}
+    
+    constexpr control_register_1 &transmit_logic_reset(bool enable) {
+        base::set<fields::tx_reset>(enable);
+        return *this;
+    }
+    
+    constexpr bool transmit_logic_reset() const {
+        return base::get<fields::tx_reset>();
+    }
+    
+    constexpr control_register_1 &receive_logic_reset(bool enable) {
+        base::set<fields::rx_reset>(enable);
+        return *this;
+    }
+    
+    constexpr bool receive_logic_reset() const {
+        return base::get<fields::rx_reset>();
+    }
+    
+    constexpr control_register_1 &dma_start(bool enable) {
+        base::set<fields::dma_start>(enable);
+        return *this;
+    }
+    
+    constexpr bool dma_start() const {
+        return base::get<fields::dma_start>();
+    }
+    
+    /**
+     * Selects checksum calculation instead of copying for
+     * the DMA engine.
+     */
+    constexpr control_register_1 &checksum(bool enable) {
+        base::set<fields::checksum>(enable);
+        return *this;
+    }
+    
+    constexpr bool checksum() const {
+        return base::get<fields::checksum>();
+    }
+    
+    constexpr control_register_1 &transmit_request(bool enable) {
+        base::set<fields::tx_request>(enable);
+        return *this;
+    }
+    
+    constexpr bool transmit_request() const {
+        return base::get<fields::tx_request>();
+    }
+    
+    constexpr control_register_1 &receive(bool enable) {
+        base::set<fields::rx_enable>(enable);
+        return *this;
+    }
+    
+    constexpr bool receive() const {
+        return base::get<fields::rx_enable>();
+    }
+    
+    constexpr control_register_1 &bank_select(std::uint8_t bank) {
+        base::set<fields::bank_select>(bank);
+        return *this;
+    }
+    
+    constexpr std::uint8_t bank_select() const {
+        return base::get<fields::bank_select>();
+    }
+};
+
+class control_register_2 : public base_register<std::uint8_t> {
+    using base = base_register<std::uint8_t>;
+    
+    struct fields {
+        using auto_increment = base::field<0x80>;
+        using packet_decrement = base::field<0x40>;
+        using power_save = base::field<0x20>;
+        using voltage_regulator_power_save = base::field<0x08>;
+    };
+    
+    static_assert(disjoint<fields::auto_increment, fields::packet_decrement,
+                           fields::power_save,
+                           fields::voltage_regulator_power_save>());
+    
+public:
+    static constexpr register_address address = eth::address::econ2;
+    
+    constexpr control_register_2() {
+        auto_increment(true);
+        packet_decrement(false);
+        power_save(false);
+        voltage_regulator_power_save(false);
+    }
+    
+    constexpr control_register_2(std::uint8_t data) : base(data) {}
+    
+    constexpr control_register_2 &auto_increment(bool enable) {
+        base::set<fields::auto_increment>(enable);
+        return *this;
+    }
+    
+    constexpr bool auto_increment() const {
+        return base::get<fields::auto_increment>();
+    }
+    
+    constexpr control_register_2 &packet_decrement(bool enable) {
+        base::set<fields::packet_decrement>(enable);
+        return *this;
+    }
+    
+    constexpr bool packet_decrement() const {
+        return base::get<fields::packet_decrement>();
+    }
+    
+    constexpr control_register_2 &power_save(bool enable) {
+        base::set<fields::power_save>(enable);
+        return *this;
+    }
+    
+    constexpr bool power_save() const {
+        return base::get<fields::power_save>();
+    }
+    
+    constexpr control_register_2 &voltage_regulator_power_save(bool enable) {
+        base::set<fields::voltage_regulator_power_save>(enable);
+        return *this;
+    }
+    
+    constexpr bool voltage_regulator_power_save() const {
+        return base::get<fields::voltage_regulator_power_save>();
+    }
+};
+
+class receive_filter : public base_register<std::uint8_t> {
+    using base = base_register<std::uint8_t>;
+    
+    struct fields {
+        using unicast = base::field<0x80>;
+        using and_or = base::field<0x40>;
+        using crc_check = base::field<0x20>;
+        using pattern_match = base::field<0x10>;
+        using magic_packet = base::field<0x08>;
+        using hash_table = base::field<0x04>;
+        using multicast = base::field<0x02>;
+        using broadcast = base::field<0x01>;
+    };
+    
+    static_assert(disjoint<fields::unicast, fields::and_or,
+                           fields::crc_check, fields::pattern_match,
+                           fields::magic_packet, fields::hash_table,
+                           fields::multicast, fields::broadcast>());
+                           
+public:
+    static constexpr register_address address = eth::address::erxfcon;
+    
+    constexpr receive_filter() {
+        unicast(true);
+        require_all(false);
+        crc_check(true);
+        pattern_match(false);
+        magic_packet(false);
+        hash_table(false);
+        multicast(false);
+        broadcast(true);
+    }
+    
+    constexpr receive_filter(std::uint8_t data) : base(data) {}
+    
+    /**
+     * Accepts frames addressed to MAADR.
+     */
+    constexpr receive_filter &unicast(bool enable) {
+        base::set<fields::unicast>(enable);
+        return *this;
+    }
+    
+    constexpr bool unicast() const {
+        return base::get<fields::unicast>();
+    }
+    
+    /**
+     * Frames have to match all enabled filters instead of any.
+     */
+    constexpr receive_filter &require_all(bool enable) {
+        base::set<fields::and_or>(enable);
+        return *this;
+    }
+    
+    constexpr bool require_all() const {
+        return base::get<fields::and_or>();
+    }
+    
+    /**
+     * Discards frames with an invalid CRC.
+     */
+    constexpr receive_filter &crc_check(bool enable) {
+        base::set<fields::crc_check>(enable);
+        return *this;
+    }
+    
+    constexpr bool crc_check() const {
+        return base::get<fields::crc_check>();
+    }
+    
+    constexpr receive_filter &pattern_match(bool enable) {
+        base::set<fields::pattern_match>(enable);
+        return *this;
+    }
+    
+    constexpr bool pattern_match() const {
+        return base::get<fields::pattern_match>();
+    }
+    
+    constexpr receive_filter &magic_packet(bool enable) {
+        base::set<fields::magic_packet>(enable);
+        return *this;
+    }
+    
+    constexpr bool magic_packet() const {
+        return base::get<fields::magic_packet>();
+    }
+    
+    constexpr receive_filter &hash_table(bool enable) {
+        base::set<fields::hash_table>(enable);
+        return *this;
+    }
+    
+    constexpr bool hash_table() const {
+        return base::get<fields::hash_table>();
+    }
+    
+    constexpr receive_filter &multicast(bool enable) {
+        base::set<fields::multicast>(enable);
+        return *this;
+    }
+    
+    constexpr bool multicast() const {
+        return base::get<fields::multicast>();
+    }
+    
+    constexpr receive_filter &broadcast(bool enable) {
+        base::set<fields::broadcast>(enable);
+        return *this;
+    }
+    
+    constexpr bool broadcast() const {
+        return base::get<fields::broadcast>();
+    }
+};
+
+class interrupt_enable : public base_register<std::uint8_t> {
+    using base = base_register<std::uint8_t>;
+    
+    struct fields {
+        using global = base::field<0x80>;
+        using receive = base::field<0x40>;
+        using dma = base::field<0x20>;
+        using link_change = base::field<0x10>;
+        using transmit = base::field<0x08>;
+        using transmit_error = base::field<0x02>;
+        using receive_error = base::field<0x01>;
+        
+        using reserved_0 = base::reserved<0x04, 0x00>;
+    };
+    
+    static_assert(disjoint<fields::global, fields::receive, fields::dma,
+                           fields::link_change, fields::transmit,
+                           fields::transmit_error, fields::receive_error,
+                           fields::reserved_0>());
+                           
+public:
+    static constexpr register_address address = eth::address::eie;
+    
+    constexpr interrupt_enable() {
+        base::init<fields::reserved_0>();
+    }
+    
+    constexpr interrupt_enable(std::uint8_t data) : base(data) {}
+    
+    /**
+     * Drives the INT pin while any enabled flag is set.
+     */
+    constexpr interrupt_enable &global(bool enable) {
+        base::set<fields::global>(enable);
+        return *this;
+    }
+    
+    constexpr bool global() const {
+        return base::get<fields::global>();
+    }
+    
+    constexpr interrupt_enable &receive(bool enable) {
+        base::set<fields::receive>(enable);
+        return *this;
+    }
+    
+    constexpr bool receive() const {
+        return base::get<fields::receive>();
+    }
+    
+    constexpr interrupt_enable &dma(bool enable) {
+        base::set<fields::dma>(enable);
+        return *this;
+    }
+    
+    constexpr bool dma() const {
+        return base::get<fields::dma>();
+    }
+    
+    /**
+     * Also needs PHIE.PLNKIE and PHIE.PGEIE.
+     */
+    constexpr interrupt_enable &link_change(bool enable) {
+        base::set<fields::link_change>(enable);
+        return *this;
+    }
+    
+    constexpr bool link_change() const {
+        return base::get<fields::link_change>();
+    }
+    
+    constexpr interrupt_enable &transmit(bool enable) {
+        base::set<fields::transmit>(enable);
+        return *this;
+    }
+    
+    constexpr bool transmit() const {
+        return base::get<fields::transmit>();
+    }
+    
+    constexpr interrupt_enable &transmit_error(bool enable) {
+        base::set<fields::transmit_error>(enable);
+        return *this;
+    }
+    
+    constexpr bool transmit_error() const {
+        return base::get<fields::transmit_error>();
+    }
+    
+    constexpr interrupt_enable &receive_error(bool enable) {
+        base::set<fields::receive_error>(enable);
+        return *this;
+    }
+    
+    constexpr bool receive_error() const {
+        return base::get<fields::receive_error>();
+    }
+};
+
+class interrupt_request : public base_register<std::uint8_t> {
+    using base = base_register<std::uint8_t>;
+    
+    struct fields {
+        using receive = base::field<0x40>;
+        using dma = base::field<0x20>;
+        using link_change = base::field<0x10>;
+        using transmit = base::field<0x08>;
+        using transmit_error = base::field<0x02>;
+        using receive_error = base::field<0x01>;
+        
+        using reserved_0 = base::reserved<0x80 + 0x04, 0x00>;
+    };
+    
+    static_assert(disjoint<fields::receive, fields::dma, fields::link_change,
+                           fields::transmit, fields::transmit_error,
+                           fields::receive_error, fields::reserved_0>());
+                           
+public:
+    static constexpr register_address address = eth::address::eir;
+    
+    constexpr interrupt_request() {
+        base::init<fields::reserved_0>();
+    }
+    
+    constexpr interrupt_request(std::uint8_t data) : base(data) {}
+    
+    /**
+     * PKTIF, read only. Cleared by decrementing EPKTCNT to zero.
+     */
+    constexpr interrupt_request &receive(bool enable) {
+        base::set<fields::receive>(enable);
+        return *this;
+    }
+    
+    constexpr bool receive() const {
+        return base::get<fields::receive>();
+    }
+    
+    constexpr interrupt_request &dma(bool enable) {
+        base::set<fields::dma>(enable);
+        return *this;
+    }
+    
+    constexpr bool dma() const {
+        return base::get<fields::dma>();
+    }
+    
+    /**
+     * LINKIF, read only. Cleared by reading PHIR.
+     */
+    constexpr interrupt_request &link_change(bool enable) {
+        base::set<fields::link_change>(enable);
+        return *this;
+    }
+    
+    constexpr bool link_change() const {
+        return base::get<fields::link_change>();
+    }
+    
+    constexpr interrupt_request &transmit(bool enable) {
+        base::set<fields::transmit>(enable);
+        return *this;
+    }
+    
+    constexpr bool transmit() const {
+        return base::get<fields::transmit>();
+    }
+    
+    constexpr interrupt_request &transmit_error(bool enable) {
+        base::set<fields::transmit_error>(enable);
+        return *this;
+    }
+    
+    constexpr bool transmit_error() const {
+        return base::get<fields::transmit_error>();
+    }
+    
+    constexpr interrupt_request &receive_error(bool enable) {
+        base::set<fields::receive_error>(enable);
+        return *this;
+    }
+    
+    constexpr bool receive_error() const {
+        return base::get<fields::receive_error>();
+    }
+    
+    /**
+     * Flags which have to be cleared with BFC EIR.
+     */
+    constexpr interrupt_request clearable() const {
+        return interrupt_request(static_cast<std::uint8_t>(
+            data() & ~(fields::receive::mask | fields::link_change::mask)));
+    }
+};
+
+class status : public base_register<std::uint8_t> {
+    using base = base_register<std::uint8_t>;
+    
+    struct fields {
+        using interrupt = base::field<0x80>;
+        using buffer_error = base::field<0x40>;
+        using late_collision = base::field<0x10>;
+        using receive_busy = base::field<0x04>;
+        using transmit_abort = base::field<0x02>;
+        using clock_ready = base::field<0x01>;
+    };
+    
+    static_assert(disjoint<fields::interrupt, fields::buffer_error,
+                           fields::late_collision, fields::receive_busy,
+                           fields::transmit_abort, fields::clock_ready>());
+    
+public:
+    static constexpr register_address address = eth::address::estat;
+    
+    constexpr status() = default;
+    
+    constexpr status(std::uint8_t data) : base(data) {}
+    
+    /**
+     * INT pin asserted.
+     */
+    constexpr bool interrupt() const {
+        return base::get<fields::interrupt>();
+    }
+    
+    /**
+     * BUFER, LATECOL and TXABRT are cleared with BFC ESTAT, the
+     * setters build the mask.
+     */
+    constexpr status &buffer_error(bool enable) {
+        base::set<fields::buffer_error>(enable);
+        return *this;
+    }
+    
+    constexpr bool buffer_error() const {
+        return base::get<fields::buffer_error>();
+    }
+    
+    constexpr status &late_collision(bool enable) {
+        base::set<fields::late_collision>(enable);
+        return *this;
+    }
+    
+    constexpr bool late_collision() const {
+        return base::get<fields::late_collision>();
+    }
+    
+    constexpr bool receive_busy() const {
+        return base::get<fields::receive_busy>();
+    }
+    
+    constexpr status &transmit_abort(bool enable) {
+        base::set<fields::transmit_abort>(enable);
+        return *this;
+    }
+    
+    constexpr bool transmit_abort() const {
+        return base::get<fields::transmit_abort>();
+    }
+    
+    constexpr bool clock_ready() const {
+        return base::get<fields::clock_ready>();
+    }
+};
+
+class flow_control : public base_register<std::uint8_t> {
+    using base = base_register<std::uint8_t>;
+    
+public:
+    static constexpr register_address address = eth::address::eflocon;
+    
+    /**
+     * FCEN1:FCEN0, meaning depends on the duplex mode.
+     */
+    enum flow_conf : std::uint8_t {
+        off = 0b00,
+        
+        /**
+         * Full duplex: send one pause frame with the EPAUS pause
+         * time, then turn flow control off.
+         */
+        pause_once = 0b01,
+        
+        /**
+         * Full duplex: keep sending pause frames with the EPAUS
+         * pause time.
+         */
+        pause_periodic = 0b10,
+        
+        /**
+         * Full duplex: send one pause frame with a zero pause time,
+         * releasing the link partner, then turn flow control off.
+         */
+        pause_release = 0b11,
+        
+        /**
+         * Half duplex: jam the medium, only FCEN0 is used.
+         */
+        back_pressure = 0b01
+    };
+    
+private:
+    struct fields {
+        using full_duplex = base::field<0x04>;
+        using mode = base::field<0x02 + 0x01, flow_conf>;
+    };
+    
+    static_assert(disjoint<fields::full_duplex, fields::mode>());
+    
+public:
+    constexpr flow_control() {
+        mode(off);
+    }
+    
+    constexpr flow_control(std::uint8_t data) : base(data) {}
+    
+    /**
+     * FULDPXS, read only copy of MACON3.FULDPX.
+     */
+    constexpr bool full_duplex() const {
+        return base::get<fields::full_duplex>();
+    }
+    
+    constexpr flow_control &mode(flow_conf conf) {
+        base::set<fields::mode>(conf);
+        return *this;
+    }
+    
+    constexpr flow_conf mode() const {
+        return base::get<fields::mode>();
+    }
+};
+
+}
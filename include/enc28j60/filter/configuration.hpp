@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <enc28j60/device.hpp>
+#include <enc28j60/eth/address.hpp>
+#include <enc28j60/eth/register.hpp>
+#include <enc28j60/filter/hash_table.hpp>
+#include <enc28j60/filter/pattern.hpp>
+#include <enc28j60/spi/bus.hpp>
+
+namespace enc28j60::filter {
+
+/**
+ * Receive filter setup. All registers live in bank 1 and are written
+ * with a single bank switch.
+ */
+struct configuration {
+    eth::receive_filter control{};
+    hash_table hashes{};
+    filter::pattern pattern{};
+};
+
+inline void apply(device &dev, const configuration &config) {
+    const spi::batch batch(dev.bus());
+    
+    if (config.control.hash_table()) {
+        for (std::uint8_t i = 0; i < hash_table::size; ++i) {
+            dev.write(eth::address::eht0.offset(i), config.hashes.data()[i]);
+        }
+    }
+    
+    if (config.control.pattern_match()) {
+        for (std::uint8_t i = 0; i < 8; ++i) {
+            dev.write(eth::address::epmm0.offset(i),
+                      static_cast<std::uint8_t>(config.pattern.mask >> (8 * i)));
+        }
+        dev.write_pair(eth::address::epmcsl, config.pattern.checksum);
+        dev.write_pair(eth::address::epmol, config.pattern.offset);
+    }
+    
+    dev.write(config.control);
+}
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <enc28j60/crc/crc32.hpp>
+
+namespace enc28j60::filter {
+
+using mac_address = std::array<std::uint8_t, 6>;
+
+/**
+ * Bit of the 64 bit hash table the device checks for a destination
+ * address: bits 28:23 of the CRC-32 over the address without final
+ * inversion. The table driven CRC works bit reflected, so these are
+ * its bits 3:8 in reverse order.
+ */
+constexpr std::uint8_t hash_index(const mac_address &address) {
+    const std::uint32_t crc =
+        crc::detail::update_bytewise(crc::initial, address.data(), address.size());
+    
+    std::uint8_t index = 0;
+    for (int bit = 0; bit < 6; ++bit) {
+        index |= ((crc >> (8 - bit)) & 1) << bit;
+    }
+    return index;
+}
+
+/**
+ * Contents of EHT0-EHT7.
+ */
+class hash_table {
+public:
+    static constexpr std::size_t size = 8;
+    
+    constexpr hash_table() = default;
+    
+    constexpr hash_table(const std::array<std::uint8_t, size> &data)
+        : data_(data) {}
+    
+    template<std::size_t N>
+    constexpr hash_table(const std::array<mac_address, N> &addresses) {
+        for (const mac_address &address : addresses) {
+            add(address);
+        }
+    }
+    
+    constexpr hash_table &add(const mac_address &address) {
+        const std::uint8_t index = hash_index(address);
+        data_[index >> 3] |= 1 << (index & 0x07);
+        return *this;
+    }
+    
+    constexpr bool contains(const mac_address &address) const {
+        const std::uint8_t index = hash_index(address);
+        return data_[index >> 3] & (1 << (index & 0x07));
+    }
+    
+    constexpr bool empty() const {
+        for (std::uint8_t byte : data_) {
+            if (byte) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    constexpr const std::array<std::uint8_t, size> &data() const {
+        return data_;
+    }
+    
+private:
+    std::array<std::uint8_t, size> data_{};
+};
+
+}
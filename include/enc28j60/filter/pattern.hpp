@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace enc28j60::filter {
+
+/**
+ * Pattern match filter: the bytes selected by `mask` inside the 64
+ * byte window starting `offset` bytes into the frame have to sum up
+ * to `checksum`.
+ */
+struct pattern {
+    static constexpr std::size_t window_size = 64;
+    
+    /**
+     * EPMO, has to be even.
+     */
+    std::uint16_t offset = 0;
+    
+    /**
+     * EPMM0-EPMM7, bit n selects byte n of the window.
+     */
+    std::uint64_t mask = 0;
+    
+    /**
+     * EPMCS
+     */
+    std::uint16_t checksum = 0xffff;
+};
+
+/**
+ * Internet checksum over the bytes of `window` selected by `mask`,
+ * taken as if they were contiguous, as the device calculates it.
+ */
+constexpr std::uint16_t pattern_checksum(
+        const std::array<std::uint8_t, pattern::window_size> &window,
+        std::uint64_t mask) {
+    std::uint32_t sum = 0;
+    std::size_t selected = 0;
+    for (std::size_t i = 0; i < window.size(); ++i) {
+        if ((mask >> i) & 1) {
+            sum += selected++ & 1 ? window[i] : window[i] << 8;
+        }
+    }
+    while (sum >> 16) {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return static_cast<std::uint16_t>(~sum);
+}
+
+constexpr pattern make_pattern(
+        std::uint16_t offset,
+        const std::array<std::uint8_t, pattern::window_size> &window,
+        std::uint64_t mask) {
+    return pattern{offset, mask, pattern_checksum(window, mask)};
+}
+
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <enc28j60/device.hpp>
+#include <enc28j60/eth/address.hpp>
+#include <enc28j60/eth/register.hpp>
+#include <enc28j60/rx/ring.hpp>
+#include <enc28j60/spi/bus.hpp>
+#include <enc28j60/statistics.hpp>
+
+namespace enc28j60::flow {
+
+/**
+ * Watermarks of the flow control engine. The link partner is
+ * throttled once either mark is reached and released once both
+ * levels are back at or below the low marks.
+ */
+struct configuration {
+    /**
+     * Bytes of the receive ring in use.
+     */
+    std::uint16_t high_watermark;
+    std::uint16_t low_watermark;
+    
+    /**
+     * EPKTCNT, which drops frames once it saturates at 255.
+     */
+    std::uint8_t high_pending = 192;
+    std::uint8_t low_pending = 32;
+    
+    /**
+     * EPAUS, pause time sent in PAUSE frames in units of 512 bit
+     * times.
+     */
+    std::uint16_t pause_time = 0x1000;
+};
+
+/**
+ * Watermarks at three quarters and one quarter of the ring.
+ */
+inline configuration default_configuration(const rx::ring &ring) {
+    return configuration{
+        static_cast<std::uint16_t>(ring.size() / 4 * 3),
+        static_cast<std::uint16_t>(ring.size() / 4)};
+}
+
+/**
+ * Throttles the link partner while the receive ring fills up,
+ * instead of losing frames to RXERIF once it is full.
+ *
+ * In full duplex PAUSE frames are sent periodically while the ring
+ * is above the watermarks and a PAUSE frame with zero pause time
+ * releases the partner. In half duplex the engine switches back
+ * pressure on and off. The duplex mode is taken from
+ * EFLOCON.FULDPXS, so init() has to follow the MAC setup.
+ *
+ * MACON1.TXPAUS has to be set for PAUSE frames to be sent.
+ */
+class engine {
+public:
+    engine(device &dev, rx::ring &ring, const configuration &config)
+        : device_(dev), ring_(ring), config_(config) {}
+    
+    /**
+     * Writes EPAUS, switches flow control off and reads the duplex
+     * mode.
+     */
+    void init() {
+        const spi::batch batch(device_.bus());
+        device_.write_pair(eth::address::epausl, config_.pause_time);
+        device_.write(eth::flow_control());
+        full_duplex_ = device_.read<eth::flow_control>().full_duplex();
+        throttled_ = false;
+    }
+    
+    /**
+     * Compares ring usage and EPKTCNT with the watermarks, three
+     * register reads. To be called on PKTIF and RXERIF and after
+     * frames were drained. Returns true while the partner is
+     * throttled.
+     */
+    bool update() {
+        const std::uint16_t used = ring_.used();
+        const std::uint8_t pending = ring_.pending();
+        
+        if (!throttled_ && (used >= config_.high_watermark ||
+                            pending >= config_.high_pending)) {
+            pause();
+        } else if (throttled_ && used <= config_.low_watermark &&
+                   pending <= config_.low_pending) {
+            release();
+        }
+        return throttled_;
+    }
+    
+    bool throttled() const {
+        return throttled_;
+    }
+    
+    bool full_duplex() const {
+        return full_duplex_;
+    }
+    
+    void pause() {
+        if (throttled_) {
+            return;
+        }
+        
+        device_.write(eth::flow_control().mode(
+            full_duplex_ ? eth::flow_control::pause_periodic :
+                           eth::flow_control::back_pressure));
+        device_.stats().flow_pauses.add();
+        throttled_ = true;
+    }
+    
+    /**
+     * Releases the partner, also before the receiver is switched
+     * off.
+     */
+    void release() {
+        if (!throttled_) {
+            return;
+        }
+        
+        device_.write(eth::flow_control().mode(
+            full_duplex_ ? eth::flow_control::pause_release :
+                           eth::flow_control::off));
+        device_.stats().flow_releases.add();
+        throttled_ = false;
+    }
+    
+private:
+    device &device_;
+    rx::ring &ring_;
+    configuration config_;
+    bool full_duplex_ = false;
+    bool throttled_ = false;
+};
+
+}
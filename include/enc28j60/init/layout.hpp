@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <enc28j60/init/script.hpp>
+
+namespace enc28j60::init {
+
+/**
+ * Size of the buffer memory.
+ */
+inline constexpr std::uint16_t buffer_size = 0x2000;
+
+/**
+ * Space a transmit slot needs for a frame of `max_frame_length`
+ * bytes: control byte, frame and status vector. The FCS is counted
+ * so the slot also fits frames sent with their own FCS.
+ */
+constexpr std::uint16_t slot_size(std::uint16_t max_frame_length) {
+    return static_cast<std::uint16_t>(1 + max_frame_length + 7);
+}
+
+/**
+ * Partition of the buffer memory into the receive ring, equally
+ * sized transmit slots for tx::queue and the free rest, e.g. for
+ * DMA scratch space.
+ */
+struct layout {
+    /**
+     * ERXST, ERXND and ETXST.
+     */
+    std::uint16_t rx_start;
+    std::uint16_t rx_end;
+    std::uint16_t tx_start;
+    
+    std::uint16_t slot_size;
+    std::size_t slots;
+    
+    /**
+     * MAMXFL.
+     */
+    std::uint16_t max_frame_length;
+    
+    constexpr std::uint16_t rx_size() const {
+        return static_cast<std::uint16_t>(rx_end - rx_start + 1);
+    }
+    
+    constexpr std::uint16_t slot_start(std::size_t index) const {
+        return static_cast<std::uint16_t>(tx_start + index * slot_size);
+    }
+    
+    /**
+     * First byte behind the transmit slots.
+     */
+    constexpr std::uint16_t free_start() const {
+        return slot_start(slots);
+    }
+    
+    constexpr std::uint16_t free_size() const {
+        return static_cast<std::uint16_t>(buffer_size - free_start());
+    }
+    
+    /**
+     * Takes over the buffer limits and MAMXFL into `config`. Huge
+     * frames are disabled, otherwise the MAC would not enforce
+     * MAMXFL and longer frames could overrun a slot.
+     */
+    constexpr configuration apply(configuration config) const {
+        config.rx_start = rx_start;
+        config.rx_end = rx_end;
+        config.tx_start = tx_start;
+        config.max_frame_length = max_frame_length;
+        config.macon3.huge_frame(false);
+        return config;
+    }
+};
+
+/**
+ * Plans a layout with a receive ring of `RxSize` bytes followed by
+ * `Slots` transmit slots for frames up to `MaxFrameLength` bytes,
+ * rejecting layouts the device can't run at compile time:
+ *
+ *     constexpr auto plan = init::plan<0x1400, 2>();
+ *     rx::ring ring(dev, plan.rx_start, plan.rx_end);
+ *     tx::queue<plan.slots> queue(dev, plan.tx_start, plan.slot_size);
+ */
+template<std::uint16_t RxSize, std::size_t Slots,
+         std::uint16_t MaxFrameLength = 1518>
+constexpr layout plan() {
+    static_assert(MaxFrameLength >= 64,
+                  "Frames shorter than the Ethernet minimum.");
+    static_assert(RxSize % 2 == 0,
+                  "The ring starts at 0 (silicon errata), so an even size "
+                  "is needed for the odd ERXND.");
+    static_assert(RxSize >= 6 + MaxFrameLength + 1,
+                  "The ring must hold one frame of maximum length with its "
+                  "header, a larger frame would never be received.");
+    static_assert(Slots >= 2, "tx::queue requires at least two slots.");
+    static_assert(RxSize + Slots * slot_size(MaxFrameLength) <= buffer_size,
+                  "Receive ring and transmit slots exceed the 8 KB buffer.");
+    
+    return layout{
+        0x0000,
+        static_cast<std::uint16_t>(RxSize - 1),
+        RxSize,
+        slot_size(MaxFrameLength),
+        Slots,
+        MaxFrameLength};
+}
+
+/**
+ * The largest receive ring next to `Slots` transmit slots, for
+ * receive heavy workloads.
+ */
+template<std::size_t Slots, std::uint16_t MaxFrameLength = 1518>
+constexpr layout plan_receive_heavy() {
+    constexpr std::size_t used = Slots * slot_size(MaxFrameLength);
+    constexpr std::uint16_t rx_size = used < buffer_size ?
+        static_cast<std::uint16_t>((buffer_size - used) & ~1u) : 0;
+    return plan<rx_size, Slots, MaxFrameLength>();
+}
+
+/**
+ * As many transmit slots as fit next to a receive ring of `RxSize`
+ * bytes, for transmit heavy workloads.
+ */
+template<std::uint16_t RxSize, std::uint16_t MaxFrameLength = 1518>
+constexpr layout plan_transmit_heavy() {
+    constexpr std::size_t slots = RxSize < buffer_size ?
+        (buffer_size - RxSize) / slot_size(MaxFrameLength) : 0;
+    return plan<RxSize, slots, MaxFrameLength>();
+}
+
+}
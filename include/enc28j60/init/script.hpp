@@ -0,0 +1,325 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <enc28j60/detail/register_address.hpp>
+#include <enc28j60/device.hpp>
+#include <enc28j60/eth/address.hpp>
+#include <enc28j60/eth/register.hpp>
+#include <enc28j60/filter/hash_table.hpp>
+#include <enc28j60/mac/address.hpp>
+#include <enc28j60/mac/register.hpp>
+#include <enc28j60/phy/register.hpp>
+#include <enc28j60/spi/bus.hpp>
+#include <enc28j60/spi/opcode.hpp>
+
+namespace enc28j60::init {
+
+/**
+ * Complete device configuration applied after a system reset.
+ */
+struct configuration {
+    // MACON2 is left out on purpose: later datasheet revisions mark
+    // it reserved and drop it from the MAC initialization, the MAC
+    // leaves a system reset ready to run.
+    mac::control_register_1 macon1{};
+    mac::control_register_3 macon3{};
+    mac::control_register_4 macon4{};
+    mac::btb_inter_package_gap mabbipg{};
+    
+    /**
+     * Non back-to-back inter packet gap, MAIPGL in the low and
+     * MAIPGH in the high byte.
+     */
+    std::uint16_t inter_packet_gap = 0x0c12;
+    
+    std::uint16_t max_frame_length = 1518;
+    
+    std::array<std::uint8_t, 6> mac_address{};
+    
+    /**
+     * Inclusive limits of the receive ring and start of the
+     * transmit area.
+     */
+    std::uint16_t rx_start = 0x0000;
+    std::uint16_t rx_end = 0x17ff;
+    std::uint16_t tx_start = 0x1800;
+    
+    eth::receive_filter receive_filter{};
+    
+    /**
+     * EHT0-EHT7, only written if receive_filter enables the hash
+     * table filter.
+     */
+    filter::hash_table hash_table{};
+    
+    phy::control_register_1 phcon1{};
+    phy::led_control phlcon{};
+    
+    bool enable_receive = true;
+    
+    /**
+     * Used to space the PHY writes 10.24 us apart.
+     */
+    std::uint32_t spi_frequency = 20000000;
+};
+
+/**
+ * Every command of a script is exactly two bytes long, so the
+ * image can be sent by a DMA engine using 16 bit frames with a
+ * chip select pulse after each frame.
+ */
+inline constexpr std::size_t command_size = 2;
+
+namespace detail {
+
+template<std::size_t N>
+class sink {
+public:
+    constexpr void push(spi::opcode op, register_address reg, std::uint8_t data) {
+        if (size_ + command_size <= N) {
+            data_[size_] = spi::encode(op, reg.address);
+            data_[size_ + 1] = data;
+        }
+        size_ += command_size;
+    }
+    
+    constexpr std::size_t size() const {
+        return size_;
+    }
+    
+    constexpr const std::array<std::uint8_t, N> &data() const {
+        return data_;
+    }
+    
+private:
+    std::array<std::uint8_t, N> data_{};
+    std::size_t size_ = 0;
+};
+
+constexpr std::uint8_t switch_cost(std::uint8_t from, std::uint8_t to) {
+    return ((from & ~to) ? 1 : 0) + ((to & ~from) ? 1 : 0);
+}
+
+/**
+ * Order of banks 0, 1 and 3 with the fewest bank switch commands
+ * starting from bank 0. Bank 2 always comes last so the final PHY
+ * write overlaps with whatever follows the script.
+ */
+constexpr std::array<std::uint8_t, 4> bank_order() {
+    std::array<std::uint8_t, 4> best{0, 1, 3, 2};
+    unsigned best_cost = ~0u;
+    const std::array<std::uint8_t, 3> banks{0, 1, 3};
+    
+    for (std::size_t a = 0; a < 3; ++a) {
+        for (std::size_t b = 0; b < 3; ++b) {
+            if (b == a) {
+                continue;
+            }
+            const std::size_t c = 3 - a - b;
+            const std::array<std::uint8_t, 4> order{banks[a], banks[b], banks[c], 2};
+            
+            unsigned cost = 0;
+            std::uint8_t current = 0;
+            for (std::uint8_t bank : order) {
+                cost += switch_cost(current, bank);
+                current = bank;
+            }
+            if (cost < best_cost) {
+                best_cost = cost;
+                best = order;
+            }
+        }
+    }
+    return best;
+}
+
+template<typename Sink>
+constexpr void select(Sink &sink, std::uint8_t &current, std::uint8_t bank) {
+    if (current & ~bank) {
+        sink.push(spi::opcode::bit_field_clear, eth::address::econ1, current & ~bank);
+    }
+    if (bank & ~current) {
+        sink.push(spi::opcode::bit_field_set, eth::address::econ1, bank & ~current);
+    }
+    current = bank;
+}
+
+template<typename Sink>
+constexpr void write(Sink &sink, register_address reg, std::uint8_t value) {
+    sink.push(spi::opcode::write_control_register, reg, value);
+}
+
+template<typename Sink>
+constexpr void write_pair(Sink &sink, register_address low, std::uint16_t value) {
+    write(sink, low, static_cast<std::uint8_t>(value));
+    write(sink, low.high(), static_cast<std::uint8_t>(value >> 8));
+}
+
+template<typename Sink>
+constexpr void write_phy(Sink &sink, register_address reg, std::uint16_t value) {
+    write(sink, mac::address::miregadr, reg.address);
+    write_pair(sink, mac::address::miwrl, value);
+}
+
+/**
+ * Commands needed to cover the MII access time.
+ */
+constexpr std::size_t mii_commands(std::uint32_t spi_frequency) {
+    const std::uint64_t bits = 8 * command_size;
+    return static_cast<std::size_t>(
+        (10240ull * spi_frequency + bits * 1000000000ull - 1) /
+        (bits * 1000000000ull));
+}
+
+template<typename Sink>
+constexpr void generate(const configuration &config, Sink &sink) {
+    std::uint8_t current = 0;
+    
+    for (std::uint8_t bank : bank_order()) {
+        select(sink, current, bank);
+        
+        switch (bank) {
+        case 0:
+            write_pair(sink, eth::address::erxstl, config.rx_start);
+            write_pair(sink, eth::address::erxndl, config.rx_end);
+            write_pair(sink, eth::address::erxrdptl, config.rx_end);
+            write_pair(sink, eth::address::etxstl, config.tx_start);
+            break;
+            
+        case 1:
+            if (config.receive_filter.hash_table()) {
+                for (std::uint8_t i = 0; i < filter::hash_table::size; ++i) {
+                    write(sink, eth::address::eht0.offset(i),
+                          config.hash_table.data()[i]);
+                }
+            }
+            write(sink, eth::address::erxfcon, config.receive_filter.data());
+            break;
+            
+        case 2: {
+            write_phy(sink, phy::address::phcon1, config.phcon1.data());
+            const std::size_t issued = sink.size();
+            
+            write(sink, mac::address::macon1, config.macon1.data());
+            write(sink, mac::address::macon3, config.macon3.data());
+            write(sink, mac::address::macon4, config.macon4.data());
+            write(sink, mac::address::mabbipg, config.mabbipg.data());
+            write_pair(sink, mac::address::maipgl, config.inter_packet_gap);
+            write_pair(sink, mac::address::mamxfll, config.max_frame_length);
+            
+            // no-op commands until the PHCON1 write has completed
+            const std::size_t needed = mii_commands(config.spi_frequency);
+            for (std::size_t i = (sink.size() - issued) / command_size;
+                 i < needed; ++i) {
+                sink.push(spi::opcode::bit_field_set, eth::address::econ1, 0);
+            }
+            
+            write_phy(sink, phy::address::phlcon, config.phlcon.data());
+            break;
+        }
+        
+        case 3:
+            write(sink, mac::address::maadr1, config.mac_address[0]);
+            write(sink, mac::address::maadr2, config.mac_address[1]);
+            write(sink, mac::address::maadr3, config.mac_address[2]);
+            write(sink, mac::address::maadr4, config.mac_address[3]);
+            write(sink, mac::address::maadr5, config.mac_address[4]);
+            write(sink, mac::address::maadr6, config.mac_address[5]);
+            break;
+        }
+    }
+    
+    if (config.enable_receive) {
+        sink.push(spi::opcode::bit_field_set, eth::address::econ1,
+                  eth::control_register_1(0).receive(true).data());
+    }
+}
+
+/**
+ * Bank switches in a script. A switch is one BFC and/or one BFS of
+ * ECON1.BSEL right after each other, as select() issues them.
+ */
+template<std::size_t N>
+constexpr std::size_t bank_switches(const std::array<std::uint8_t, N> &image) {
+    const std::uint8_t clear =
+        spi::encode(spi::opcode::bit_field_clear, eth::address::econ1.address);
+    const std::uint8_t set =
+        spi::encode(spi::opcode::bit_field_set, eth::address::econ1.address);
+    const std::uint8_t bsel = eth::control_register_1(0).bank_select(3).data();
+    
+    std::size_t count = 0;
+    bool previous = false;
+    for (std::size_t i = 0; i < N; i += command_size) {
+        const bool bank =
+            (image[i] == clear || image[i] == set) && (image[i + 1] & bsel);
+        if (bank && !previous) {
+            ++count;
+        }
+        previous = bank;
+    }
+    return count;
+}
+
+/**
+ * Not constexpr on purpose: reaching it during constant evaluation
+ * turns a wrong script size into a compile error.
+ */
+inline void script_size_mismatch() {
+    std::abort();
+}
+
+}
+
+/**
+ * Size in bytes of the script generated for `config`.
+ */
+constexpr std::size_t script_size(const configuration &config) {
+    detail::sink<0> sink;
+    detail::generate(config, sink);
+    return sink.size();
+}
+
+/**
+ * Builds the SPI command image for `config`. It has to be applied
+ * right after a system reset once ESTAT.CLKRDY is set.
+ *
+ *     constexpr init::configuration config = ...;
+ *     constexpr auto image = init::script<init::script_size(config)>(config);
+ */
+template<std::size_t N>
+constexpr std::array<std::uint8_t, N> script(const configuration &config) {
+    detail::sink<N> sink;
+    detail::generate(config, sink);
+    if (sink.size() != N) {
+        detail::script_size_mismatch();
+    }
+    return sink.data();
+}
+
+/**
+ * Sends a script one command per transaction, for buses without a
+ * suitable DMA engine.
+ */
+template<std::size_t N>
+void play(spi::bus &bus, const std::array<std::uint8_t, N> &image) {
+    static_assert(N % command_size == 0, "Invalid script.");
+    
+    const spi::batch batch(bus);
+    for (std::size_t i = 0; i < N; i += command_size) {
+        bus.transfer(&image[i], nullptr, command_size);
+    }
+}
+
+template<std::size_t N>
+void play(device &dev, const std::array<std::uint8_t, N> &image) {
+    play(dev.transport().bus(), image);
+    dev.stats().spi_transactions.add(N / command_size);
+    dev.stats().spi_bytes.add(N);
+    dev.stats().bank_switches.add(detail::bank_switches(image));
+    dev.invalidate_bank();
+}
+
+}
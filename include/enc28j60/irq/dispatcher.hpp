@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <poll.h>
+#include <enc28j60/device.hpp>
+#include <enc28j60/eth/address.hpp>
+#include <enc28j60/eth/register.hpp>
+#include <enc28j60/irq/line.hpp>
+#include <enc28j60/statistics.hpp>
+
+namespace enc28j60::irq {
+
+/**
+ * Waits for the INT pin and dispatches the EIR flags to handlers.
+ *
+ * Each wake-up costs four short SPI transactions: EIE.INTIE is
+ * cleared, EIR is read once, the flags that need it are cleared
+ * with a single BFC and INTIE is set again. Re-enabling INTIE
+ * releases and re-asserts the pin if flags are still pending, so
+ * an edge triggered line never misses them.
+ *
+ * PKTIF and LINKIF can't be cleared through EIR: the receive
+ * handler has to drain the ring until EPKTCNT is zero and the link
+ * handler has to read PHIR.
+ */
+class dispatcher {
+public:
+    using handler = std::function<void()>;
+    
+    dispatcher(device &dev, line &line) : device_(dev), line_(line) {}
+    
+    /**
+     * Enables the given interrupt sources and EIE.INTIE.
+     */
+    void enable(eth::interrupt_enable sources) {
+        sources_ = sources.global(true);
+        device_.write(sources_);
+        enabled_ = true;
+    }
+    
+    /**
+     * The sources of the last enable(), the dispatcher's copy of
+     * EIE.
+     */
+    eth::interrupt_enable sources() const {
+        return sources_;
+    }
+    
+    /**
+     * Clears EIE.INTIE. service() leaves it cleared until the next
+     * enable().
+     */
+    void disable() {
+        device_.clear_bits(eth::address::eie, global_enable);
+        enabled_ = false;
+    }
+    
+    void on_receive(handler h) {
+        receive_ = std::move(h);
+    }
+    
+    void on_transmit(handler h) {
+        transmit_ = std::move(h);
+    }
+    
+    void on_receive_error(handler h) {
+        receive_error_ = std::move(h);
+    }
+    
+    void on_transmit_error(handler h) {
+        transmit_error_ = std::move(h);
+    }
+    
+    void on_link_change(handler h) {
+        link_change_ = std::move(h);
+    }
+    
+    void on_dma(handler h) {
+        dma_ = std::move(h);
+    }
+    
+    /**
+     * Blocks until INT is asserted or `timeout_ms` has passed, a
+     * negative value waits forever. Returns false on timeout and
+     * right away if the line has no descriptor.
+     */
+    bool wait(int timeout_ms = -1) {
+        if (line_.fd() < 0) {
+            return false;
+        }
+        
+        pollfd descriptor{line_.fd(), POLLIN | POLLPRI, 0};
+        if (::poll(&descriptor, 1, timeout_ms) <= 0) {
+            return false;
+        }
+        
+        line_.acknowledge();
+        service();
+        return true;
+    }
+    
+    /**
+     * Handles the flags currently set without waiting. To be called
+     * once after enable() for flags raised before the line was
+     * armed.
+     */
+    eth::interrupt_request service() {
+        const statistics::timer timer(device_.stats().interrupt_latency);
+        if (enabled_) {
+            device_.clear_bits(eth::address::eie, global_enable);
+        }
+        
+        const eth::interrupt_request flags(device_.read(eth::address::eir));
+        const std::uint8_t clear = flags.clearable().data();
+        if (clear) {
+            device_.clear_bits(eth::address::eir, clear);
+        }
+        
+        count(flags);
+        
+        dispatch(flags.receive_error(), receive_error_);
+        dispatch(flags.transmit_error(), transmit_error_);
+        dispatch(flags.transmit(), transmit_);
+        dispatch(flags.receive(), receive_);
+        dispatch(flags.dma(), dma_);
+        dispatch(flags.link_change(), link_change_);
+        
+        // a handler may have called disable()
+        if (enabled_) {
+            device_.set_bits(eth::address::eie, global_enable);
+        }
+        return flags;
+    }
+    
+private:
+    static constexpr std::uint8_t global_enable =
+        eth::interrupt_enable(0).global(true).data();
+    
+    void count(eth::interrupt_request flags) {
+        statistics &stats = device_.stats();
+        stats.interrupts.add();
+        if (!flags.data()) {
+            stats.interrupts_spurious.add();
+        }
+        if (flags.receive_error()) {
+            stats.rx_overflows.add();
+        }
+        if (flags.transmit_error()) {
+            stats.tx_errors.add();
+        }
+    }
+    
+    static void dispatch(bool raised, const handler &h) {
+        if (raised && h) {
+            h();
+        }
+    }
+    
+    device &device_;
+    line &line_;
+    eth::interrupt_enable sources_;
+    bool enabled_ = false;
+    
+    handler receive_;
+    handler transmit_;
+    handler receive_error_;
+    handler transmit_error_;
+    handler link_change_;
+    handler dma_;
+};
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <enc28j60/irq/line.hpp>
+
+namespace enc28j60::irq {
+
+/**
+ * INT pin connected to a GPIO, requested from a Linux GPIO
+ * character device like /dev/gpiochip0 for falling edge events
+ * through the v2 uAPI (Linux 5.10 and later).
+ *
+ * The pin is active low and only produces a new edge after it has
+ * been released, dispatcher::service() takes care of that by
+ * toggling EIE.INTIE.
+ */
+class gpio_line : public line {
+public:
+    gpio_line(const char *chip, std::uint32_t offset,
+              const char *consumer = "enc28j60") {
+        const int chip_fd = ::open(chip, O_RDONLY | O_CLOEXEC);
+        if (chip_fd < 0) {
+            return;
+        }
+        
+        gpio_v2_line_request request{};
+        request.offsets[0] = offset;
+        request.num_lines = 1;
+        request.config.flags =
+            GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+        std::strncpy(request.consumer, consumer, sizeof(request.consumer) - 1);
+        
+        if (::ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &request) == 0) {
+            fd_ = request.fd;
+            ::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL) | O_NONBLOCK);
+        }
+        ::close(chip_fd);
+    }
+    
+    gpio_line(const gpio_line &) = delete;
+    gpio_line &operator=(const gpio_line &) = delete;
+    
+    ~gpio_line() override {
+        if (valid()) {
+            ::close(fd_);
+        }
+    }
+    
+    bool valid() const {
+        return fd_ >= 0;
+    }
+    
+    int fd() const override {
+        return fd_;
+    }
+    
+    void acknowledge() override {
+        gpio_v2_line_event event;
+        while (::read(fd_, &event, sizeof(event)) == sizeof(event)) {
+        }
+    }
+    
+    /**
+     * Current level of the pin, true if asserted.
+     */
+    bool asserted() const {
+        gpio_v2_line_values values{};
+        values.mask = 1;
+        if (::ioctl(fd_, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) != 0) {
+            return false;
+        }
+        return !(values.bits & 1);
+    }
+    
+private:
+    int fd_ = -1;
+};
+
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace enc28j60::irq {
+
+/**
+ * The INT pin of the device as seen by the host: a file descriptor
+ * which becomes readable when the pin is asserted.
+ */
+class line {
+public:
+    virtual ~line() = default;
+    
+    virtual int fd() const = 0;
+    
+    /**
+     * Consumes the pending events after fd() became readable.
+     */
+    virtual void acknowledge() = 0;
+};
+
+/**
+ * Line backed by a pipe, triggered by software. Stands in for the
+ * GPIO line in tests, e.g. driven by sim::chip::on_interrupt().
+ */
+class pipe_line : public line {
+public:
+    pipe_line() {
+        int fds[2];
+        if (::pipe(fds) == 0) {
+            read_fd_ = fds[0];
+            write_fd_ = fds[1];
+            ::fcntl(read_fd_, F_SETFL, ::fcntl(read_fd_, F_GETFL) | O_NONBLOCK);
+            ::fcntl(write_fd_, F_SETFL, ::fcntl(write_fd_, F_GETFL) | O_NONBLOCK);
+        }
+    }
+    
+    pipe_line(const pipe_line &) = delete;
+    pipe_line &operator=(const pipe_line &) = delete;
+    
+    ~pipe_line() override {
+        if (valid()) {
+            ::close(read_fd_);
+            ::close(write_fd_);
+        }
+    }
+    
+    bool valid() const {
+        return read_fd_ >= 0;
+    }
+    
+    int fd() const override {
+        return read_fd_;
+    }
+    
+    void acknowledge() override {
+        std::uint8_t buffer[64];
+        while (::read(read_fd_, buffer, sizeof(buffer)) > 0) {
+        }
+    }
+    
+    /**
+     * Signals an asserted INT pin.
+     */
+    void trigger() {
+        const std::uint8_t event = 1;
+        [[maybe_unused]] const auto written = ::write(write_fd_, &event, 1);
+    }
+    
+private:
+    int read_fd_ = -1;
+    int write_fd_ = -1;
+};
+
+}
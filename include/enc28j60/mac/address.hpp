@@ -0,0 +1,48 @@
+#pragma once
+
+#include <enc28j60/detail/register_address.hpp>
+
+namespace enc28j60::mac::address {
+
+namespace detail {
+
+constexpr register_address make_mac(register_bank bank, std::uint8_t address) {
+    return {address, bank, register_kind::mac};
+}
+
+constexpr register_address make_mii(register_bank bank, std::uint8_t address) {
+    return {address, bank, register_kind::mii};
+}
+
+}
+
+// bank 2
+inline constexpr register_address macon1 = detail::make_mac(register_bank::bank_2, 0x00);
+inline constexpr register_address macon2 = detail::make_mac(register_bank::bank_2, 0x01);
+inline constexpr register_address macon3 = detail::make_mac(register_bank::bank_2, 0x02);
+inline constexpr register_address macon4 = detail::make_mac(register_bank::bank_2, 0x03);
+inline constexpr register_address mabbipg = detail::make_mac(register_bank::bank_2, 0x04);
+inline constexpr register_address maipgl = detail::make_mac(register_bank::bank_2, 0x06);
+inline constexpr register_address maipgh = detail::make_mac(register_bank::bank_2, 0x07);
+inline constexpr register_address maclcon1 = detail::make_mac(register_bank::bank_2, 0x08);
+inline constexpr register_address maclcon2 = detail::make_mac(register_bank::bank_2, 0x09);
+inline constexpr register_address mamxfll = detail::make_mac(register_bank::bank_2, 0x0a);
+inline constexpr register_address mamxflh = detail::make_mac(register_bank::bank_2, 0x0b);
+inline constexpr register_address maphsup = detail::make_mac(register_bank::bank_2, 0x0d);
+inline constexpr register_address micmd = detail::make_mii(register_bank::bank_2, 0x12);
+inline constexpr register_address miregadr = detail::make_mii(register_bank::bank_2, 0x14);
+inline constexpr register_address miwrl = detail::make_mii(register_bank::bank_2, 0x16);
+inline constexpr register_address miwrh = detail::make_mii(register_bank::bank_2, 0x17);
+inline constexpr register_address mirdl = detail::make_mii(register_bank::bank_2, 0x18);
+inline constexpr register_address mirdh = detail::make_mii(register_bank::bank_2, 0x19);
+
+// bank 3
+inline constexpr register_address maadr5 = detail::make_mac(register_bank::bank_3, 0x00);
+inline constexpr register_address maadr6 = detail::make_mac(register_bank::bank_3, 0x01);
+inline constexpr register_address maadr3 = detail::make_mac(register_bank::bank_3, 0x02);
+inline constexpr register_address maadr4 = detail::make_mac(register_bank::bank_3, 0x03);
+inline constexpr register_address maadr1 = detail::make_mac(register_bank::bank_3, 0x04);
+inline constexpr register_address maadr2 = detail::make_mac(register_bank::bank_3, 0x05);
+inline constexpr register_address mistat = detail::make_mii(register_bank::bank_3, 0x0a);
+
+}
@@ -2,23 +2,28 @@
 
 #include <cstdint>
 #include <enc28j60/detail/base_register.hpp>
+#include <enc28j60/mac/address.hpp>
 
 namespace enc28j60::mac {
 
 class control_register_1 : public base_register<std::uint8_t> {
     using base = base_register<std::uint8_t>;
     
-    struct bits {
-        enum : std::uint8_t {
-            loopback = 0x10,
-            tx_pause = 0x08,
-            rx_pause = 0x04,
-            pass_all = 0x02,
-            rx_enable = 0x01
-        };
+    struct fields {
+        using loopback = base::field<0x10>;
+        using tx_pause = base::field<0x08>;
+        using rx_pause = base::field<0x04>;
+        using pass_all = base::field<0x02>;
+        using rx_enable = base::field<0x01>;
     };
     
+    static_assert(disjoint<fields::loopback, fields::tx_pause,
+                           fields::rx_pause, fields::pass_all,
+                           fields::rx_enable>());
+    
 public:
+    static constexpr register_address address = mac::address::macon1;
+    
     constexpr control_register_1() {
         loopback(false);
         transmit_pause_frames(true);
@@ -30,66 +35,70 @@ public:
     constexpr control_register_1(std::uint8_t data) : base(data) {}
     
     constexpr control_register_1 &loopback(bool enable) {
-        base::set_bits(bits::loopback, enable);
+        base::set<fields::loopback>(enable);
         return *this;
     }
     
     constexpr bool loopback() const {
-        return base::check_bits(bits::loopback);
+        return base::get<fields::loopback>();
     }
     
     constexpr control_register_1 &transmit_pause_frames(bool enable) {
-        base::set_bits(bits::tx_pause, enable);
+        base::set<fields::tx_pause>(enable);
         return *this;
     }
     
     constexpr bool transmit_pause_frames() const {
-        return base::check_bits(bits::tx_pause);
+        return base::get<fields::tx_pause>();
     }
     
     constexpr control_register_1 &receive_pause_frames(bool enable) {
-        base::set_bits(bits::rx_pause, enable);
+        base::set<fields::rx_pause>(enable);
         return *this;
     }
     
     constexpr bool receive_pause_frames() const {
-        return base::check_bits(bits::rx_pause);
+        return base::get<fields::rx_pause>();
     }
     
     constexpr control_register_1 &pass_all(bool enable) {
-        base::set_bits(bits::pass_all, enable);
+        base::set<fields::pass_all>(enable);
         return *this;
     }
     
     constexpr bool pass_all() const {
-        return base::check_bits(bits::pass_all);
+        return base::get<fields::pass_all>();
     }
     
     constexpr control_register_1 &receive(bool enable) {
-        base::set_bits(bits::rx_enable);
+        base::set<fields::rx_enable>(enable);
         return *this;
     }
     
-    constexpr bool receive(bool enable) const {
-        return base::check_bits(bits::rx_enable);
+    constexpr bool receive() const {
+        return base::get<fields::rx_enable>();
     }
 };
 
 class control_register_2 : public base_register<std::uint8_t> {
     using base = base_register<std::uint8_t>;
     
-    struct bits {
-        enum : std::uint8_t {
-            reset = 0x80,
-            rng_reset = 0x40,
-            rx_reset = 0x08,
-            rx_function_reset = 0x04,
-            tx_reset = 0x02,
-            tx_function_reset = 0x01
-        };
+    struct fields {
+        using reset = base::field<0x80>;
+        using rng_reset = base::field<0x40>;
+        using rx_reset = base::field<0x08>;
+        using rx_function_reset = base::field<0x04>;
+        using tx_reset = base::field<0x02>;
+        using tx_function_reset = base::field<0x01>;
     };
     
+    static_assert(disjoint<fields::reset, fields::rng_reset,
+                           fields::rx_reset, fields::rx_function_reset,
+                           fields::tx_reset, fields::tx_function_reset>());
+    
 public:
+    static constexpr register_address address = mac::address::macon2;
+    
     constexpr control_register_2() {
         reset(false);
         reset_random_number_generator(false);
@@ -102,75 +111,66 @@ public:
     constexpr control_register_2(std::uint8_t data) : base(data) {}
     
     constexpr control_register_2 &reset(bool enable) {
-        base::set_bits(bits::reset, enable);
+        base::set<fields::reset>(enable);
         return *this;
     }
     
     constexpr bool reset() const {
-        return base::check_bits(bits::reset);
+        return base::get<fields::reset>();
     }
     
     constexpr control_register_2 &reset_random_number_generator(bool enable) {
-        base::set_bits(bits::rng_reset, enable);
+        base::set<fields::rng_reset>(enable);
         return *this;
     }
     
     constexpr bool reset_random_number_generator() const {
-        return base::check_bits(bits::rng_reset);
+        return base::get<fields::rng_reset>();
     }
     
     constexpr control_register_2 &reset_receive_logic(bool enable) {
-        base::set_bits(bits::rx_reset, enable);
+        base::set<fields::rx_reset>(enable);
         return *this;
     }
     
     constexpr bool reset_receive_logic() const {
-        return base::check_bits(bits::rx_reset);
+        return base::get<fields::rx_reset>();
     }
     
     constexpr control_register_2 &reset_receive_function(bool enable) {
-        base::set_bits(bits::rx_function_reset, enable);
+        base::set<fields::rx_function_reset>(enable);
         return *this;
     }
     
     constexpr bool reset_receive_function() const {
-        return base::check_bits(bits::rx_function_reset);
+        return base::get<fields::rx_function_reset>();
     }
     
     constexpr control_register_2 &reset_transmit_logic(bool enable) {
-        base::set_bits(bits::tx_reset, enable);
+        base::set<fields::tx_reset>(enable);
         return *this;
     }
     
     constexpr bool reset_transmit_logic() const {
-        return base::check_bits(bits::tx_reset);
+        return base::get<fields::tx_reset>();
     }
     
     constexpr control_register_2 &reset_transmit_function(bool enable) {
-        base::set_bits(bits::tx_function_reset, enable);
+        base::set<fields::tx_function_reset>(enable);
         return *this;
     }
     
     constexpr bool reset_transmit_function() const {
-        return base::check_bits(bits::tx_function_reset);
+        return base::get<fields::tx_function_reset>();
     }
 };
 
 class control_register_3 : public base_register<std::uint8_t> {
     using base = base_register<std::uint8_t>;
     
-    struct bits {
-        enum : std::uint8_t {
-            pad_crc = 0x80 + 0x40 + 0x20,
-            tx_crc = 0x10,
-            proprietary_header = 0x08,
-            huge_frame = 0x04,
-            frame_length_check = 0x02,
-            full_duplex = 0x01
-        };
-    };
-    
 public:
+    static constexpr register_address address = mac::address::macon3;
+    
     enum pad_conf : std::uint8_t {
         /**
          * MAC will automatically detect VLAN Protocol frames
@@ -179,19 +179,19 @@ public:
          * will be padded to 60 bytes. After padding, a valid
          * CRC will be appended.
          */
-        pad_60_vlan_64 = 0x80 + 0x20,
+        pad_60_vlan_64 = 0b101,
         
         /**
          * All short frames will be zero padded to 64 bytes and
          * a valid CRC will then be appended.
          */
-        pad_64 = 0x40 + 0x20,
+        pad_64 = 0b011,
         
         /**
          * All short frames will be zero padded to 60 bytes and
          * a valid CRC will then be appended.
          */
-        pad_60 = 0x20,
+        pad_60 = 0b001,
         
         /**
          * No automatic padding of short frames.
@@ -199,6 +199,21 @@ public:
         no_pad = 0
     };
     
+private:
+    struct fields {
+        using pad_crc = base::field<0x80 + 0x40 + 0x20, pad_conf>;
+        using tx_crc = base::field<0x10>;
+        using proprietary_header = base::field<0x08>;
+        using huge_frame = base::field<0x04>;
+        using frame_length_check = base::field<0x02>;
+        using full_duplex = base::field<0x01>;
+    };
+    
+    static_assert(disjoint<fields::pad_crc, fields::tx_crc,
+                           fields::proprietary_header, fields::huge_frame,
+                           fields::frame_length_check, fields::full_duplex>());
+    
+public:
     constexpr control_register_3() {
         auto_padding(pad_60_vlan_64);
         transmit_crc(false);
@@ -211,75 +226,80 @@ public:
     constexpr control_register_3(std::uint8_t data) : base(data) {}
     
     constexpr control_register_3 &transmit_crc(bool enable) {
-        base::set_bits(bits::tx_crc, enable);
+        base::set<fields::tx_crc>(enable);
         return *this;
     }
     
     constexpr bool transmit_crc() const {
-        return base::check_bits(bits::tx_crc);
+        return base::get<fields::tx_crc>();
     }
     
     constexpr control_register_3 &proprietary_header(bool enable) {
-        base::set_bits(bits::proprietary_header, enable);
+        base::set<fields::proprietary_header>(enable);
         return *this;
     }
     
     constexpr bool proprietary_header() const {
-        return base::check_bits(bits::proprietary_header);
+        return base::get<fields::proprietary_header>();
     }
     
     constexpr control_register_3 &huge_frame(bool enable) {
-        base::set_bits(bits::huge_frame, enable);
+        base::set<fields::huge_frame>(enable);
         return *this;
     }
     
     constexpr bool huge_frame() const {
-        return base::check_bits(bits::huge_frame);
+        return base::get<fields::huge_frame>();
     }
     
     constexpr control_register_3 &check_frame_length(bool enable) {
-        base::set_bits(bits::frame_length_check, enable);
+        base::set<fields::frame_length_check>(enable);
         return *this;
     }
     
     constexpr bool check_frame_length() const {
-        return base::check_bits(bits::frame_length_check);
+        return base::get<fields::frame_length_check>();
     }
     
     constexpr control_register_3 &full_duplex(bool enable) {
-        base::set_bits(bits::full_duplex, enable);
+        base::set<fields::full_duplex>(enable);
         return *this;
     }
     
     constexpr bool full_duplex() const {
-        return base::check_bits(bits::full_duplex);
+        return base::get<fields::full_duplex>();
     }
     
     constexpr control_register_3 &auto_padding(pad_conf conf) {
-        base::set_bits(bits::pad_crc, 0);
-        base::set_bits(conf, 1);
+        base::set<fields::pad_crc>(conf);
         return *this;
     }
     
     constexpr pad_conf auto_padding() const {
-        return pad_conf{base::get_bits(bits::pad_crc)};
+        return base::get<fields::pad_crc>();
     }
 };
 
 class control_register_4 : public base_register<std::uint8_t> {
     using base = base_register<std::uint8_t>;
     
-    struct bits {
-        enum : std::uint8_t {
-            defer_transmission = 0x40,
-            no_backoff_on_back_pressure = 0x20,
-            no_backoff = 0x10,
-            long_preamble_enforcement = 0x02,
-            pure_preamble_enforcement = 0x01
-        };
+    struct fields {
+        using defer_transmission = base::field<0x40>;
+        using no_backoff_on_back_pressure = base::field<0x20>;
+        using no_backoff = base::field<0x10>;
+        using long_preamble_enforcement = base::field<0x02>;
+        using pure_preamble_enforcement = base::field<0x01>;
     };
     
+    static_assert(disjoint<fields::defer_transmission,
+                           fields::no_backoff_on_back_pressure,
+                           fields::no_backoff,
+                           fields::long_preamble_enforcement,
+                           fields::pure_preamble_enforcement>());
+    
 public:
+    static constexpr register_address address = mac::address::macon4;
+    
     constexpr control_register_4() {
         defer_transmission(false);
         no_backoff_on_back_pressure(false);
@@ -290,62 +310,62 @@ public:
     
     constexpr control_register_4(std::uint8_t data) : base(data) {}
     
-    constexpr control_register_4 defer_transmission(bool enable) {
-        base::set_bits(bits::defer_transmission, enable);
+    constexpr control_register_4 &defer_transmission(bool enable) {
+        base::set<fields::defer_transmission>(enable);
         return *this;
     }
     
     constexpr bool defer_transmission() const {
-        return base::check_bits(bits::defer_transmission);
+        return base::get<fields::defer_transmission>();
     }
     
-    constexpr control_register_4 no_backoff_on_back_pressure(bool enable) {
-        base::set_bits(bits::no_backoff_on_back_pressure, enable);
+    constexpr control_register_4 &no_backoff_on_back_pressure(bool enable) {
+        base::set<fields::no_backoff_on_back_pressure>(enable);
         return *this;
     }
     
     constexpr bool no_backoff_on_back_pressure() const {
-        return base::check_bits(bits::no_backoff_on_back_pressure);
+        return base::get<fields::no_backoff_on_back_pressure>();
     }
     
-    constexpr control_register_4 no_backoff(bool enable) {
-        base::set_bits(bits::no_backoff, enable);
+    constexpr control_register_4 &no_backoff(bool enable) {
+        base::set<fields::no_backoff>(enable);
         return *this;
     }
     
     constexpr bool no_backoff() const {
-        return base::check_bits(bits::no_backoff);
+        return base::get<fields::no_backoff>();
     }
     
-    constexpr control_register_4 long_preamble_enforcement(bool enable) {
-        base::set_bits(bits::long_preamble_enforcement, enable);
+    constexpr control_register_4 &long_preamble_enforcement(bool enable) {
+        base::set<fields::long_preamble_enforcement>(enable);
         return *this;
     }
     
     constexpr bool long_preamble_enforcement() const {
-        return base::check_bits(bits::long_preamble_enforcement);
+        return base::get<fields::long_preamble_enforcement>();
     }
     
-    constexpr control_register_4 pure_preamble_enforcement(bool enable) {
-        base::set_bits(bits::pure_preamble_enforcement, enable);
+    constexpr control_register_4 &pure_preamble_enforcement(bool enable) {
+        base::set<fields::pure_preamble_enforcement>(enable);
         return *this;
     }
     
     constexpr bool pure_preamble_enforcement() const {
-        return base::check_bits(bits::pure_preamble_enforcement);
+        return base::get<fields::pure_preamble_enforcement>();
     }
 };
 
 class btb_inter_package_gap : public base_register<std::uint8_t> {
     using base = base_register<std::uint8_t>;
     
-    struct bits {
-        enum : std::uint8_t {
-            delay = 0xff - 0x80
-        };
+    struct fields {
+        using delay = base::field<0xff - 0x80, std::uint8_t>;
     };
     
 public:
+    static constexpr register_address address = mac::address::mabbipg;
+    
     constexpr btb_inter_package_gap() {
         delay(0x15);
     }
@@ -353,57 +373,135 @@ public:
     constexpr btb_inter_package_gap(std::uint8_t data) : base(data) {}
     
     constexpr btb_inter_package_gap &delay(std::uint8_t time) {
-        base::set_bits(bits::delay, 0);
-        base::set_bits(time & bits::delay, 1);
+        base::set<fields::delay>(time);
         return *this;
     }
     
     constexpr std::uint8_t delay() const {
-        return base::get_bits(bits::delay);
+        return base::get<fields::delay>();
     }
 };
 
 class phy_support : public base_register<std::uint8_t> {
     using base = base_register<std::uint8_t>;
     
-    struct bits {
-        enum : std::uint8_t {
-            interface_reset = 0x80,
-            reserved_4 = 0x10,
-            rmii_reset = 0x08,
-            reserved_0 = 0x01
-        };
+    struct fields {
+        using interface_reset = base::field<0x80>;
+        using rmii_reset = base::field<0x08>;
+        
+        using reserved_4 = base::reserved<0x10, 0x10>;
+        using reserved_0 = base::reserved<0x01, 0x00>;
     };
     
+    static_assert(disjoint<fields::interface_reset, fields::rmii_reset,
+                           fields::reserved_4, fields::reserved_0>());
+    
 public:
+    static constexpr register_address address = mac::address::maphsup;
+    
     constexpr phy_support() {
         init_reserved();
         interface_reset(false);
         rmii_reset(false);
     }
     
+    constexpr phy_support(std::uint8_t data) : base(data) {}
+    
     constexpr phy_support &interface_reset(bool enable) {
-        base::set_bits(bits::interface_reset, enable);
+        base::set<fields::interface_reset>(enable);
         return *this;
     }
     
     constexpr bool interface_reset() const {
-        return base::check_bits(bits::interface_reset);
+        return base::get<fields::interface_reset>();
     }
     
     constexpr phy_support &rmii_reset(bool enable) {
-        base::set_bits(bits::rmii_reset, enable);
+        base::set<fields::rmii_reset>(enable);
         return *this;
     }
     
     constexpr bool rmii_reset() const {
-        return base::check_bits(bits::rmii_reset);
+        return base::get<fields::rmii_reset>();
     }
     
 private:
     constexpr void init_reserved() {
-        base::set_bits(bits::reserved_4, 1);
-        base::set_bits(bits::reserved_0, 0);
+        base::init<fields::reserved_4>();
+        base::init<fields::reserved_0>();
+    }
+};
+
+class mii_command : public base_register<std::uint8_t> {
+    using base = base_register<std::uint8_t>;
+    
+    struct fields {
+        using scan = base::field<0x02>;
+        using read = base::field<0x01>;
+    };
+    
+    static_assert(disjoint<fields::scan, fields::read>());
+    
+public:
+    static constexpr register_address address = mac::address::micmd;
+    
+    constexpr mii_command() {
+        scan(false);
+        read(false);
+    }
+    
+    constexpr mii_command(std::uint8_t data) : base(data) {}
+    
+    constexpr mii_command &scan(bool enable) {
+        base::set<fields::scan>(enable);
+        return *this;
+    }
+    
+    constexpr bool scan() const {
+        return base::get<fields::scan>();
+    }
+    
+    constexpr mii_command &read(bool enable) {
+        base::set<fields::read>(enable);
+        return *this;
+    }
+    
+    constexpr bool read() const {
+        return base::get<fields::read>();
+    }
+};
+
+class mii_status : public base_register<std::uint8_t> {
+    using base = base_register<std::uint8_t>;
+    
+    struct fields {
+        using not_valid = base::field<0x04>;
+        using scan = base::field<0x02>;
+        using busy = base::field<0x01>;
+    };
+    
+    static_assert(disjoint<fields::not_valid, fields::scan, fields::busy>());
+    
+public:
+    static constexpr register_address address = mac::address::mistat;
+    
+    constexpr mii_status() = default;
+    
+    constexpr mii_status(std::uint8_t data) : base(data) {}
+    
+    /**
+     * MIRDL/MIRDH do not hold a scan result yet.
+     */
+    constexpr bool not_valid() const {
+        return base::get<fields::not_valid>();
+    }
+    
+    constexpr bool scan() const {
+        return base::get<fields::scan>();
+    }
+    
+    constexpr bool busy() const {
+        return base::get<fields::busy>();
     }
 };
 
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <vector>
+
+namespace enc28j60::pcap {
+
+/**
+ * LINKTYPE_ETHERNET
+ */
+inline constexpr std::uint32_t link_type_ethernet = 1;
+
+struct record {
+    /**
+     * Capture time in nanoseconds since the epoch.
+     */
+    std::uint64_t timestamp;
+    
+    /**
+     * Length of the frame on the wire, data may be shorter if the
+     * capture was truncated.
+     */
+    std::uint32_t original_size;
+    
+    std::vector<std::uint8_t> data;
+};
+
+/**
+ * Reads Ethernet frames from a classic pcap file, with either
+ * microsecond or nanosecond timestamps in either byte order.
+ */
+class reader {
+public:
+    /**
+     * Largest record accepted regardless of the snapshot length in
+     * the file header.
+     */
+    static constexpr std::uint32_t max_record_size = 65535;
+    
+    explicit reader(const char *path) : file_(std::fopen(path, "rb")) {
+        if (!file_) {
+            return;
+        }
+        
+        std::uint8_t header[24];
+        if (std::fread(header, 1, sizeof(header), file_) != sizeof(header)) {
+            close();
+            return;
+        }
+        
+        const std::uint32_t magic = load(header);
+        if (magic == 0xd4c3b2a1 || magic == 0x4d3cb2a1) {
+            swapped_ = true;
+        } else if (magic != 0xa1b2c3d4 && magic != 0xa1b23c4d) {
+            close();
+            return;
+        }
+        nanoseconds_ = magic == 0xa1b23c4d || magic == 0x4d3cb2a1;
+        snap_length_ = load(header + 16);
+        
+        if (load(header + 20) != link_type_ethernet) {
+            close();
+        }
+    }
+    
+    reader(const reader &) = delete;
+    reader &operator=(const reader &) = delete;
+    
+    ~reader() {
+        close();
+    }
+    
+    bool valid() const {
+        return file_ != nullptr;
+    }
+    
+    /**
+     * Returns std::nullopt at the end of the file or if a record
+     * is incomplete. A record longer than the snapshot length or
+     * `max_record_size` makes the reader invalid.
+     */
+    std::optional<record> next() {
+        std::uint8_t header[16];
+        if (!file_ ||
+            std::fread(header, 1, sizeof(header), file_) != sizeof(header)) {
+            return std::nullopt;
+        }
+        
+        const std::uint64_t seconds = load(header);
+        const std::uint64_t fraction = load(header + 4);
+        
+        record r;
+        r.timestamp = seconds * 1000000000 +
+                      (nanoseconds_ ? fraction : fraction * 1000);
+        r.original_size = load(header + 12);
+        
+        const std::uint32_t size = load(header + 8);
+        if (size > snap_length_ || size > max_record_size) {
+            close();
+            return std::nullopt;
+        }
+        r.data.resize(size);
+        
+        if (std::fread(r.data.data(), 1, r.data.size(), file_) != r.data.size()) {
+            return std::nullopt;
+        }
+        return r;
+    }
+    
+private:
+    std::uint32_t load(const std::uint8_t *p) const {
+        if (swapped_) {
+            return std::uint32_t(p[0]) << 24 | std::uint32_t(p[1]) << 16 |
+                   std::uint32_t(p[2]) << 8 | p[3];
+        }
+        return std::uint32_t(p[3]) << 24 | std::uint32_t(p[2]) << 16 |
+               std::uint32_t(p[1]) << 8 | p[0];
+    }
+    
+    void close() {
+        if (file_) {
+            std::fclose(file_);
+            file_ = nullptr;
+        }
+    }
+    
+    std::FILE *file_;
+    bool swapped_ = false;
+    bool nanoseconds_ = false;
+    std::uint32_t snap_length_ = 0;
+};
+
+/**
+ * Writes Ethernet frames to a pcap file with nanosecond
+ * timestamps in host byte order.
+ */
+class writer {
+public:
+    static constexpr std::uint32_t snap_length = 65535;
+    
+    explicit writer(const char *path) : file_(std::fopen(path, "wb")) {
+        struct {
+            std::uint32_t magic = 0xa1b23c4d;
+            std::uint16_t major = 2;
+            std::uint16_t minor = 4;
+            std::uint32_t zone = 0;
+            std::uint32_t accuracy = 0;
+            std::uint32_t snap_length = writer::snap_length;
+            std::uint32_t link_type = link_type_ethernet;
+        } header;
+        static_assert(sizeof(header) == 24);
+        
+        if (file_ && std::fwrite(&header, sizeof(header), 1, file_) != 1) {
+            std::fclose(file_);
+            file_ = nullptr;
+        }
+    }
+    
+    writer(const writer &) = delete;
+    writer &operator=(const writer &) = delete;
+    
+    ~writer() {
+        if (file_) {
+            std::fclose(file_);
+        }
+    }
+    
+    bool valid() const {
+        return file_ != nullptr;
+    }
+    
+    bool write(const std::uint8_t *frame, std::size_t size,
+               std::uint64_t timestamp) {
+        if (!file_) {
+            return false;
+        }
+        
+        const auto length = static_cast<std::uint32_t>(size);
+        const std::uint32_t header[4]{
+            static_cast<std::uint32_t>(timestamp / 1000000000),
+            static_cast<std::uint32_t>(timestamp % 1000000000),
+            length, length};
+        return std::fwrite(header, sizeof(header), 1, file_) == 1 &&
+               std::fwrite(frame, 1, size, file_) == size;
+    }
+    
+private:
+    std::FILE *file_;
+};
+
+}
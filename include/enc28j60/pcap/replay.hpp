@@ -0,0 +1,266 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <vector>
+#include <enc28j60/crc/crc32.hpp>
+#include <enc28j60/pcap/file.hpp>
+#include <enc28j60/rx/ring.hpp>
+#include <enc28j60/sim/chip.hpp>
+
+namespace enc28j60::pcap {
+
+struct replay_options {
+    /**
+     * Frames per second offered to the device. Zero follows the
+     * timestamps of the capture, scaled by `speed`.
+     */
+    double rate = 0;
+    double speed = 1;
+    
+    /**
+     * Model of the host: time spent on the bus per byte and per
+     * transaction, for chip select and system call overhead.
+     */
+    std::uint32_t spi_frequency = 20000000;
+    std::uint32_t transaction_ns = 2000;
+};
+
+struct replay_report {
+    std::uint64_t frames = 0;
+    std::uint64_t received = 0;
+    
+    /**
+     * Frames lost because the receive ring was full (EIR.RXERIF).
+     */
+    std::uint64_t overflows = 0;
+    std::uint64_t filtered = 0;
+    
+    /**
+     * Frames lost for any other reason, like reception being
+     * disabled.
+     */
+    std::uint64_t dropped = 0;
+    std::uint64_t transmitted = 0;
+    
+    /**
+     * Corrupted ring headers, each one reinitializes the ring.
+     */
+    std::uint64_t errors = 0;
+    
+    std::uint64_t spi_bytes = 0;
+    std::uint64_t transactions = 0;
+    
+    /**
+     * Simulated time from the first frame until the ring was
+     * drained.
+     */
+    std::uint64_t duration_ns = 0;
+    
+    /**
+     * Time from arrival on the wire until the frame was read out
+     * of the ring, in order of reception.
+     */
+    std::vector<std::uint64_t> latencies;
+    
+    double frames_per_second() const {
+        return duration_ns ? received * 1e9 / duration_ns : 0;
+    }
+    
+    double spi_bytes_per_frame() const {
+        return received ? double(spi_bytes) / received : 0;
+    }
+    
+    /**
+     * Latency below which the fraction `p` of the frames was
+     * received.
+     */
+    std::uint64_t latency_percentile(double p) const {
+        if (latencies.empty()) {
+            return 0;
+        }
+        std::vector<std::uint64_t> sorted(latencies);
+        const std::size_t index =
+            std::min(sorted.size() - 1, std::size_t(p * sorted.size()));
+        std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+        return sorted[index];
+    }
+};
+
+/**
+ * Replays a capture into the receive ring of a simulated device
+ * and drives the receive path in between, like a polling driver.
+ *
+ * Time is simulated: the bus traffic of the driver advances the
+ * clock according to replay_options, idle periods are skipped.
+ * This shows whether a configuration keeps up with a traffic mix
+ * without real hardware.
+ */
+class replay {
+public:
+    using handler = std::function<void(const rx::packet &)>;
+    
+    replay(sim::chip &chip, rx::ring &ring, const replay_options &options)
+        : chip_(chip), ring_(ring), options_(options) {}
+    
+    /**
+     * Called for every received frame, e.g. to transmit it again.
+     */
+    void on_frame(handler h) {
+        handler_ = std::move(h);
+    }
+    
+    /**
+     * Writes every transmitted frame to `output` with the
+     * simulated time as timestamp. Captures do not contain the
+     * FCS, so a valid one appended by the chip is left out.
+     */
+    void capture(writer &output) {
+        chip_.on_transmit([this, &output](const std::uint8_t *frame,
+                                          std::size_t size) {
+            ++report_.transmitted;
+            if (size >= fcs_size) {
+                const std::size_t length = size - fcs_size;
+                const std::uint32_t fcs = crc::compute(frame, length);
+                bool valid = true;
+                for (std::size_t i = 0; i < fcs_size; ++i) {
+                    valid = valid && frame[length + i] ==
+                        static_cast<std::uint8_t>(fcs >> (8 * i));
+                }
+                if (valid) {
+                    size = length;
+                }
+            }
+            output.write(frame, size, now());
+        });
+    }
+    
+    const replay_report &run(reader &input) {
+        report_ = replay_report{};
+        arrivals_.clear();
+        idle_ns_ = 0;
+        origin_ = chip_.stats();
+        
+        std::optional<std::uint64_t> first;
+        std::uint64_t wire_free = 0;
+        for (auto r = input.next(); r; r = input.next()) {
+            if (!first) {
+                first = r->timestamp;
+            }
+            
+            // frames cannot arrive faster than the wire carries them
+            const std::uint64_t arrival = std::max(wire_free, options_.rate > 0
+                ? static_cast<std::uint64_t>(report_.frames * 1e9 / options_.rate)
+                : static_cast<std::uint64_t>((r->timestamp - *first) / options_.speed));
+            wire_free = arrival + wire_time(r->data.size());
+            
+            service_until(arrival);
+            inject(r->data, arrival);
+        }
+        
+        while (!arrivals_.empty() && ring_.pending()) {
+            service();
+        }
+        
+        const sim::chip::statistics &stats = chip_.stats();
+        report_.spi_bytes = stats.bytes - origin_.bytes;
+        report_.transactions = stats.transactions - origin_.transactions;
+        report_.duration_ns = now();
+        return report_;
+    }
+    
+    const replay_report &report() const {
+        return report_;
+    }
+    
+    /**
+     * Current simulated time in nanoseconds.
+     */
+    std::uint64_t now() const {
+        const sim::chip::statistics &stats = chip_.stats();
+        return (stats.bytes - origin_.bytes) * 8000000000ull /
+                   options_.spi_frequency +
+               (stats.transactions - origin_.transactions) *
+                   options_.transaction_ns +
+               idle_ns_;
+    }
+    
+private:
+    static constexpr std::size_t fcs_size = 4;
+    
+    /**
+     * Time a frame of `size` bytes without FCS occupies a 10 Mb/s
+     * wire, including padding, preamble and interframe gap.
+     */
+    static std::uint64_t wire_time(std::size_t size) {
+        constexpr std::size_t preamble = 8;
+        constexpr std::size_t gap = 12;
+        constexpr std::uint64_t byte_ns = 800;
+        return (std::max<std::size_t>(size, 60) + fcs_size + preamble + gap) *
+               byte_ns;
+    }
+    
+    void inject(const std::vector<std::uint8_t> &frame, std::uint64_t time) {
+        ++report_.frames;
+        
+        const sim::chip::statistics before = chip_.stats();
+        if (chip_.receive(frame.data(), frame.size())) {
+            arrivals_.push_back(time);
+        } else if (chip_.stats().overflowed_frames !=
+                   before.overflowed_frames) {
+            ++report_.overflows;
+        } else if (chip_.stats().filtered_frames != before.filtered_frames) {
+            ++report_.filtered;
+        } else {
+            ++report_.dropped;
+        }
+    }
+    
+    void service_until(std::uint64_t time) {
+        while (now() < time) {
+            if (arrivals_.empty() || !ring_.pending()) {
+                idle_ns_ += time - now();
+                return;
+            }
+            service();
+        }
+    }
+    
+    void service() {
+        const std::optional<rx::packet> packet =
+            ring_.receive(buffer_.data(), buffer_.size());
+        if (!packet) {
+            ++report_.errors;
+            arrivals_.clear();
+            ring_.init();
+            return;
+        }
+        
+        ++report_.received;
+        report_.latencies.push_back(now() - arrivals_.front());
+        arrivals_.pop_front();
+        
+        if (handler_) {
+            handler_(*packet);
+        }
+    }
+    
+    sim::chip &chip_;
+    rx::ring &ring_;
+    replay_options options_;
+    handler handler_;
+    
+    replay_report report_;
+    sim::chip::statistics origin_{};
+    std::deque<std::uint64_t> arrivals_;
+    std::uint64_t idle_ns_ = 0;
+    
+    std::array<std::uint8_t, sim::chip::buffer_size> buffer_{};
+};
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <enc28j60/detail/register_address.hpp>
+
+namespace enc28j60::phy::address {
+
+namespace detail {
+
+constexpr register_address make(std::uint8_t address) {
+    return {address, register_bank::common, register_kind::phy};
+}
+
+}
+
+inline constexpr register_address phcon1 = detail::make(0x00);
+inline constexpr register_address phstat1 = detail::make(0x01);
+inline constexpr register_address phid1 = detail::make(0x02);
+inline constexpr register_address phid2 = detail::make(0x03);
+inline constexpr register_address phcon2 = detail::make(0x10);
+inline constexpr register_address phstat2 = detail::make(0x11);
+inline constexpr register_address phie = detail::make(0x12);
+inline constexpr register_address phir = detail::make(0x13);
+inline constexpr register_address phlcon = detail::make(0x14);
+
+}
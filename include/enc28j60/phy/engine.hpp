@@ -0,0 +1,199 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <enc28j60/detail/register_address.hpp>
+#include <enc28j60/device.hpp>
+#include <enc28j60/mac/address.hpp>
+#include <enc28j60/mac/register.hpp>
+
+namespace enc28j60::phy {
+
+/**
+ * Non-blocking access to the PHY registers through the MII
+ * interface.
+ *
+ * Operations are started and then completed by calling poll(),
+ * which never waits: until the MII access time has passed it
+ * returns without touching the bus, afterwards it checks
+ * MISTAT.BUSY once.
+ *
+ * In scan mode the MII interface continuously reads one PHY
+ * register into MIRDL/MIRDH, so polling it needs no command.
+ */
+class engine {
+public:
+    using clock = std::chrono::steady_clock;
+    
+    /**
+     * Time the MII interface needs for one operation.
+     */
+    static constexpr std::chrono::nanoseconds access_time{10240};
+    
+    enum class state {
+        idle,
+        reading,
+        writing,
+        scanning
+    };
+    
+    explicit engine(device &dev) : device_(dev) {}
+    
+    state current_state() const {
+        return state_;
+    }
+    
+    /**
+     * Starts reading a PHY register. Returns false if another
+     * operation or a scan is in progress.
+     */
+    bool start_read(register_address reg) {
+        if (state_ != state::idle) {
+            return false;
+        }
+        
+        device_.write(mac::address::miregadr, reg.address);
+        device_.write(mac::mii_command().read(true));
+        begin(state::reading);
+        return true;
+    }
+    
+    template<typename Register>
+    bool start_read() {
+        return start_read(Register::address);
+    }
+    
+    /**
+     * Starts writing a PHY register. Returns false if another
+     * operation or a scan is in progress.
+     */
+    bool start_write(register_address reg, std::uint16_t value) {
+        if (state_ != state::idle) {
+            return false;
+        }
+        
+        device_.write(mac::address::miregadr, reg.address);
+        device_.write_pair(mac::address::miwrl, value);
+        begin(state::writing);
+        return true;
+    }
+    
+    template<typename Register>
+    bool start_write(const Register &reg) {
+        return start_write(Register::address, reg.data());
+    }
+    
+    /**
+     * Advances the current read or write. Returns true once the
+     * engine is idle again, then result() holds the value of a
+     * completed read.
+     */
+    bool poll() {
+        if (state_ == state::idle) {
+            return true;
+        }
+        if (state_ == state::scanning || !elapsed() || busy()) {
+            return false;
+        }
+        
+        if (state_ == state::reading) {
+            device_.write(mac::mii_command());
+            result_ = device_.read_pair(mac::address::mirdl);
+        }
+        device_.stats().phy_latency.record(clock::now() - started_);
+        state_ = state::idle;
+        return true;
+    }
+    
+    std::uint16_t result() const {
+        return result_;
+    }
+    
+    template<typename Register>
+    Register result() const {
+        return Register(result_);
+    }
+    
+    /**
+     * Starts continuous reading of a PHY register, typically
+     * PHSTAT2 for link monitoring.
+     */
+    bool start_scan(register_address reg) {
+        if (state_ != state::idle) {
+            return false;
+        }
+        
+        device_.write(mac::address::miregadr, reg.address);
+        device_.write(mac::mii_command().scan(true));
+        scan_valid_ = false;
+        begin(state::scanning);
+        return true;
+    }
+    
+    template<typename Register>
+    bool start_scan() {
+        return start_scan(Register::address);
+    }
+    
+    /**
+     * Stops scanning. The MII interface stays busy until the
+     * running read completes, poll() reports that.
+     */
+    void stop_scan() {
+        if (state_ != state::scanning) {
+            return;
+        }
+        
+        device_.write(mac::mii_command());
+        begin(state::writing);
+    }
+    
+    /**
+     * Latest value of the scanned register, std::nullopt until
+     * the first scan completed.
+     */
+    std::optional<std::uint16_t> scanned() {
+        if (state_ != state::scanning) {
+            return std::nullopt;
+        }
+        
+        if (!scan_valid_) {
+            if (!elapsed() || device_.read<mac::mii_status>().not_valid()) {
+                return std::nullopt;
+            }
+            scan_valid_ = true;
+        }
+        return device_.read_pair(mac::address::mirdl);
+    }
+    
+    template<typename Register>
+    std::optional<Register> scanned() {
+        if (auto value = scanned()) {
+            return Register(*value);
+        }
+        return std::nullopt;
+    }
+    
+private:
+    void begin(state next) {
+        state_ = next;
+        started_ = clock::now();
+    }
+    
+    bool elapsed() const {
+        return clock::now() - started_ >= access_time;
+    }
+    
+    bool busy() {
+        return device_.read<mac::mii_status>().busy();
+    }
+    
+    device &device_;
+    state state_ = state::idle;
+    clock::time_point started_;
+    std::uint16_t result_ = 0;
+    bool scan_valid_ = false;
+};
+
+}
@@ -2,25 +2,30 @@
 
 #include <cstdint>
 #include <enc28j60/detail/base_register.hpp>
+#include <enc28j60/phy/address.hpp>
 
 namespace enc28j60::phy {
 
 class control_register_1 : public base_register<std::uint16_t> {
     using base = base_register<std::uint16_t>;
     
-    struct bits {
-        enum : std::uint16_t {
-            software_reset = 0x8000,
-            loopback = 0x4000,
-            power_down = 0x0800,
-            duplex_mode = 0x0100,
+    struct fields {
+        using software_reset = base::field<0x8000>;
+        using loopback = base::field<0x4000>;
+        using power_down = base::field<0x0800>;
+        using duplex_mode = base::field<0x0100>;
 
-            reserved_0 = 0x0400,
-            reserved_1 = 0x0080
-        };
+        using reserved_0 = base::reserved<0x0400, 0x0000>;
+        using reserved_1 = base::reserved<0x0080, 0x0080>;
     };
     
+    static_assert(disjoint<fields::software_reset, fields::loopback,
+                           fields::power_down, fields::duplex_mode,
+                           fields::reserved_0, fields::reserved_1>());
+    
 public:
+    static constexpr register_address address = phy::address::phcon1;
+    
     constexpr control_register_1() {
         init_reserved();
         software_reset(false);
@@ -32,45 +37,45 @@ public:
     constexpr control_register_1(std::uint16_t data) : base(data) {}
     
     constexpr control_register_1 &software_reset(bool enable) {
-        base::set_bits(bits::software_reset, enable);
+        base::set<fields::software_reset>(enable);
         return *this;
     }
     
     constexpr bool software_reset() const {
-        return base::check_bits(bits::software_reset);
+        return base::get<fields::software_reset>();
     }
     
     constexpr control_register_1 &loopback(bool enable) {
-        base::set_bits(bits::loopback, enable);
+        base::set<fields::loopback>(enable);
         return *this;
     }
     
     constexpr bool loopback() const {
-        return base::check_bits(bits::loopback);
+        return base::get<fields::loopback>();
     }
     
     constexpr control_register_1 &power_down(bool enable) {
-        base::set_bits(bits::power_down, enable);
+        base::set<fields::power_down>(enable);
         return *this;
     }
     
     constexpr bool power_down() const {
-        return base::check_bits(bits::power_down);
+        return base::get<fields::power_down>();
     }
     
     constexpr control_register_1 &full_duplex(bool enable) {
-        base::set_bits(bits::duplex_mode, enable);
+        base::set<fields::duplex_mode>(enable);
         return *this;
     }
     
     constexpr bool full_duplex() const {
-        return base::check_bits(bits::duplex_mode);
+        return base::get<fields::duplex_mode>();
     }
     
 private:
     constexpr void init_reserved() {
-        base::set_bits(bits::reserved_0, 0);
-        base::set_bits(bits::reserved_1, 1);
+        base::init<fields::reserved_0>();
+        base::init<fields::reserved_1>();
     }
 };
 
@@ -78,18 +83,27 @@ private:
 class control_register_2 : public base_register<std::uint16_t> {
     using base = base_register<std::uint16_t>;
     
-    struct bits {
-        enum : std::uint16_t {
-            force_linkup = 0x4000,
-            twisted_pair_transmitter_disable = 0x2000,
-            jabber_correction = 0x0400,
-            half_duplex_loopback_disable = 0x0100,
+    struct fields {
+        using force_linkup = base::field<0x4000>;
+        using twisted_pair_transmitter_disable = base::field<0x2000>;
+        using jabber_correction = base::field<0x0400>;
+        using half_duplex_loopback_disable = base::field<0x0100>;
 
-            reserved_0 = 0x1000 + 0x0800 + 0x0200 + 0x00ff
-        };
+        using reserved_0 = base::reserved<0x1000 + 0x0800, 0x0000>;
+        using reserved_1 = base::reserved<0x0200, 0x0000>;
+        using reserved_2 = base::reserved<0x00ff, 0x0000>;
     };
+    
+    static_assert(disjoint<fields::force_linkup,
+                           fields::twisted_pair_transmitter_disable,
+                           fields::jabber_correction,
+                           fields::half_duplex_loopback_disable,
+                           fields::reserved_0, fields::reserved_1,
+                           fields::reserved_2>());
 
 public:
+    static constexpr register_address address = phy::address::phcon2;
+    
     constexpr control_register_2() {
         init_reserved();
         force_linkup(false);
@@ -101,96 +115,93 @@ public:
     constexpr control_register_2(std::uint16_t data) : base(data) {}
     
     constexpr control_register_2 &force_linkup(bool enable) {
-        base::set_bits(bits::force_linkup, enable);
+        base::set<fields::force_linkup>(enable);
         return *this;
     }
     
     constexpr bool force_linkup() const {
-        return base::check_bits(bits::force_linkup);
+        return base::get<fields::force_linkup>();
     }
     
     constexpr control_register_2 &disable_twisted_pair_transmitter(bool enable) {
-        base::set_bits(bits::twisted_pair_transmitter_disable, enable);
+        base::set<fields::twisted_pair_transmitter_disable>(enable);
         return *this;
     }
     
     constexpr bool disable_twisted_pair_transmitter() const {
-        return base::check_bits(bits::twisted_pair_transmitter_disable);
+        return base::get<fields::twisted_pair_transmitter_disable>();
     }
     
     constexpr control_register_2 &jabber_correction(bool enable) {
-        base::set_bits(bits::jabber_correction, enable);
+        base::set<fields::jabber_correction>(enable);
         return *this;
     }
     
     constexpr bool jabber_correction() const {
-        return base::check_bits(bits::jabber_correction);
+        return base::get<fields::jabber_correction>();
     }
     
     constexpr control_register_2 &disable_half_duplex_loopback(bool enable) {
-        base::set_bits(bits::half_duplex_loopback_disable, enable);
+        base::set<fields::half_duplex_loopback_disable>(enable);
         return *this;
     }
     
     constexpr bool disable_half_duplex_loopback() const {
-        return base::check_bits(bits::half_duplex_loopback_disable);
+        return base::get<fields::half_duplex_loopback_disable>();
     }
     
 private:
     constexpr void init_reserved() {
-        base::set_bits(bits::reserved_0, 0);
+        base::init<fields::reserved_0>();
+        base::init<fields::reserved_1>();
+        base::init<fields::reserved_2>();
     }
 };
 
 class device_id_1 : public base_register<std::uint16_t> {
     using base = base_register<std::uint16_t>;
     
-    struct bits {
-        enum : std::uint16_t {
-            identifier = 0xffff
-        };
+    struct fields {
+        using identifier = base::field<0xffff, std::uint16_t>;
     };
 
 public:
+    static constexpr register_address address = phy::address::phid1;
+    
     constexpr device_id_1(std::uint16_t data) : base(data) {}
     
     constexpr std::uint16_t upper_identifier() const {
-        return base::get_bits(bits::identifier);
+        return base::get<fields::identifier>();
     }
 };
 
 class device_id_2 : public base_register<std::uint16_t> {
     using base = base_register<std::uint16_t>;
     
-    struct bits {
-        enum : std::uint16_t {
-            identifier = 0xf000 + 0x0800 + 0x0400,
-            part_number = 0x00f0 + 0x0200 + 0x0100,
-            revision = 0x000f
-        };
+    struct fields {
+        using identifier = base::field<0xf000 + 0x0800 + 0x0400, std::uint16_t>;
+        using part_number = base::field<0x00f0 + 0x0200 + 0x0100, std::uint16_t>;
+        using revision = base::field<0x000f, std::uint8_t>;
     };
     
-    struct shifts {
-        enum {
-            identifier = 10,
-            part_number = 4,
-            revision = 0
-        };
-    };
+    static_assert(disjoint<fields::identifier, fields::part_number,
+                           fields::revision>());
 
 public:
+    static constexpr register_address address = phy::address::phid2;
+    
     constexpr device_id_2(std::uint16_t data) : base(data) {}
     
     constexpr std::uint16_t lower_identifier() const {
-        return base::get_bits(bits::identifier) >> shifts::identifier;
+        return base::get<fields::identifier>();
     }
     
     constexpr std::uint16_t part_number() const {
-        return base::get_bits(bits::part_number) >> shifts::part_number;
+        return base::get<fields::part_number>();
     }
     
     constexpr std::uint8_t revision_level() const {
-        return base::get_bits(bits::revision) >> shifts::revision;
+        return base::get<fields::revision>();
     }
 };
 
@@ -205,8 +216,9 @@ public:
         : device_id_1(id1), device_id_2(id2) {}; 
     
     constexpr std::uint32_t identifier() const {
-        return device_id_2::lower_identifier() + 
-            (device_id_1::upper_identifier() >> length::lower_identifier);
+        return device_id_2::lower_identifier() | 
+            (static_cast<std::uint32_t>(device_id_1::upper_identifier())
+                << length::lower_identifier);
     }
     
     constexpr std::uint16_t part_number() const {
@@ -226,22 +238,23 @@ public:
     }
 };
 
-class interrupt_request;
-
 class interrupt_enable : public base_register<std::uint16_t> {
     using base = base_register<std::uint16_t>;
     
-    friend interrupt_request;
+    struct fields {
+        using link_change = base::field<0x0010>;
+        using global = base::field<0x0002>;
     
-    struct bits {
-        enum : std::uint16_t {
-            link_change = 0x0010,
-            global = 0x0002,
-            reserved_0 = 0xffff - global - link_change
-        };
+        using reserved_0 = base::reserved<0xffe0, 0x0000>;
+        using reserved_1 = base::reserved<0x000c + 0x0001, 0x0000>;
     };
+    
+    static_assert(disjoint<fields::link_change, fields::global,
+                           fields::reserved_0, fields::reserved_1>());
 
 public:
+    static constexpr register_address address = phy::address::phie;
+    
     constexpr interrupt_enable() {
         init_reserved();
     }
@@ -249,68 +262,58 @@ public:
     constexpr interrupt_enable(std::uint16_t data) : base(data) {}
     
     constexpr interrupt_enable &link_change(bool enable) {
-        base::set_bits(bits::link_change, enable);
+        base::set<fields::link_change>(enable);
         return *this;
     }
     
     constexpr bool link_change() const {
-        return base::check_bits(bits::link_change);
+        return base::get<fields::link_change>();
     }
     
     constexpr interrupt_enable &global(bool enable) {
-        base::set_bits(bits::global, enable);
+        base::set<fields::global>(enable);
         return *this;
     }
     
     constexpr bool global() const {
-        return base::check_bits(bits::global);
+        return base::get<fields::global>();
     }
     
 private:
     constexpr void init_reserved() {
-        base::set_bits(bits::reserved_0, 0);
+        base::init<fields::reserved_0>();
+        base::init<fields::reserved_1>();
     }
 };
 
 class interrupt_request: public base_register<std::uint16_t> {
     using base = base_register<std::uint16_t>;
     
-    using bits = interrupt_enable::bits;
+    struct fields {
+        using link_change = base::field<0x0010>;
+        using global = base::field<0x0004>;
+    };
 
 public:
+    static constexpr register_address address = phy::address::phir;
+    
     constexpr interrupt_request(std::uint16_t data) : base(data) {}
     
     constexpr bool link_change() const {
-        return base::check_bits(bits::link_change);
+        return base::get<fields::link_change>();
     }
     
     constexpr bool global() const {
-        return base::check_bits(bits::global);
+        return base::get<fields::global>();
     }
 };
 
 class led_control: public base_register<std::uint16_t> {
     using base = base_register<std::uint16_t>;
-    
-    struct bits {
-        enum : std::uint16_t {
-            led_a = 0x0f00,
-            led_b = 0x00f0,
-            pulse_stretch_time = 0x0008 + 0x0004,
-            pulse_stretch = 0x0002,
-            reserved_0 = 0xf000 + 0x0001
-        };
-    };
-    
-    struct shifts {
-        enum {
-            led_a = 16,
-            led_b = 8,
-            pulse_stretch_time = 2
-        };
-    };
 
 public:
+    static constexpr register_address address = phy::address::phlcon;
+    
     enum led_conf : std::uint8_t {
         display_tx_activity = 0b0001,
         display_rx_activity = 0b0010,
@@ -327,12 +330,28 @@ public:
         display_duplex_status_and_collision_acitvity = 0b1110
     };
     
-    enum time_conf {
+    enum time_conf : std::uint8_t {
         ms_139 = 0b10,
         ms_73 = 0b01,
         ms_40 = 0b00
     };
     
+private:
+    struct fields {
+        using led_a = base::field<0x0f00, led_conf>;
+        using led_b = base::field<0x00f0, led_conf>;
+        using pulse_stretch_time = base::field<0x0008 + 0x0004, time_conf>;
+        using pulse_stretch = base::field<0x0002>;
+        
+        using reserved_0 = base::reserved<0xc000 + 0x0001, 0x0000>;
+        using reserved_1 = base::reserved<0x3000, 0x3000>;
+    };
+    
+    static_assert(disjoint<fields::led_a, fields::led_b,
+                           fields::pulse_stretch_time, fields::pulse_stretch,
+                           fields::reserved_0, fields::reserved_1>());
+
+public:
     constexpr led_control() {
         init_reserved();
         led_a(display_link_status);
@@ -344,128 +363,119 @@ public:
     constexpr led_control(std::uint16_t data) : base(data) {}
     
     constexpr led_control &led_a(led_conf conf) {
-        base::set_bits(bits::led_a, 0);
-        base::set_bits(conf << shifts::led_a, 1);
+        base::set<fields::led_a>(conf);
         return *this;
     }
     
     constexpr led_conf led_a() const {
-        return led_conf{
-                static_cast<uint8_t>(
-                    base::get_bits(bits::led_a) >> shifts::led_a)};
+        return base::get<fields::led_a>();
     }
     
     constexpr led_control &led_b(led_conf conf) {
-        base::set_bits(bits::led_b, 0);
-        base::set_bits(conf << shifts::led_b, 1);
+        base::set<fields::led_b>(conf);
         return *this;
     }
     
     constexpr led_conf led_b() const {
-        return led_conf{
-                static_cast<uint8_t>(
-                    base::get_bits(bits::led_b) >> shifts::led_b)};
+        return base::get<fields::led_b>();
     }
     
     constexpr led_control &pulse_stretch_time(time_conf conf) {
-        base::set_bits(bits::pulse_stretch_time, 0);
-        base::set_bits(conf << shifts::pulse_stretch_time, 1);
+        base::set<fields::pulse_stretch_time>(conf);
         return *this;
     }
     
-    constexpr led_conf pulse_stretch_time() const {
-        return led_conf{
-                static_cast<uint8_t>(
-                    base::get_bits(bits::pulse_stretch_time) >>
-                        shifts::pulse_stretch_time)};
+    constexpr time_conf pulse_stretch_time() const {
+        return base::get<fields::pulse_stretch_time>();
     }
     
     constexpr led_control &pulse_stretching(bool enable) {
-        base::set_bits(bits::pulse_stretch, enable);
+        base::set<fields::pulse_stretch>(enable);
         return *this;
     }
     
     constexpr bool pulse_stretching() const {
-        return base::check_bits(bits::pulse_stretch);
+        return base::get<fields::pulse_stretch>();
     }
     
 private:
     constexpr void init_reserved() {
-        base::set_bits(bits::reserved_0, 0);
+        base::init<fields::reserved_0>();
+        base::init<fields::reserved_1>();
     }
 };
 
 class status_1: public base_register<std::uint16_t> {
     using base = base_register<std::uint16_t>;
     
-    struct bits {
-        enum : std::uint16_t {
-            full_duplex_cap = 0x1000,
-            half_duplex_cap = 0x0800,
-            latching_link = 0x0004,
-            latching_jabber = 0x0002
-        };
+    struct fields {
+        using full_duplex_cap = base::field<0x1000>;
+        using half_duplex_cap = base::field<0x0800>;
+        using latching_link = base::field<0x0004>;
+        using latching_jabber = base::field<0x0002>;
     };
 
 public:
+    static constexpr register_address address = phy::address::phstat1;
+    
     constexpr status_1(std::uint16_t data) : base(data) {}
     
     constexpr bool full_duplex_capable() const {
-        return base::check_bits(bits::full_duplex_cap);
+        return base::get<fields::full_duplex_cap>();
     }
     
     constexpr bool half_duplex_capable() const {
-        return base::check_bits(bits::half_duplex_cap);
+        return base::get<fields::half_duplex_cap>();
     }
     
     constexpr bool link_up_latched() const {
-        return base::check_bits(bits::latching_link);
+        return base::get<fields::latching_link>();
     }
     
     constexpr bool jabber_latched() const {
-        return base::check_bits(bits::latching_jabber);
+        return base::get<fields::latching_jabber>();
     }
 };
 
 class status_2: public base_register<std::uint16_t> {
     using base = base_register<std::uint16_t>;
 
-    struct bits {
-        enum : std::uint16_t {
-            tx_status = 0x2000,
-            rx_status = 0x1000,
-            collision_status = 0x0800,
-            link_status = 0x0400,
-            duplex_status = 0x0200,
-            polarity_status = 0x0010
-        };
+    struct fields {
+        using tx_status = base::field<0x2000>;
+        using rx_status = base::field<0x1000>;
+        using collision_status = base::field<0x0800>;
+        using link_status = base::field<0x0400>;
+        using duplex_status = base::field<0x0200>;
+        using polarity_status = base::field<0x0010>;
     };
     
 public:
+    static constexpr register_address address = phy::address::phstat2;
+    
     constexpr status_2(std::uint16_t data) : base(data) {}
     
     constexpr bool transmitting() const {
-        return base::check_bits(bits::tx_status);
+        return base::get<fields::tx_status>();
     }
     
     constexpr bool receiving() const {
-        return base::check_bits(bits::rx_status);
+        return base::get<fields::rx_status>();
     }
     
     constexpr bool collision_occured() const {
-        return base::check_bits(bits::collision_status);
+        return base::get<fields::collision_status>();
     }
     
     constexpr bool link_up() const {
-        return base::check_bits(bits::link_status);
+        return base::get<fields::link_status>();
     }
     
     constexpr bool full_duplex() const {
-        return base::check_bits(bits::duplex_status);
+        return base::get<fields::duplex_status>();
     }
     
     constexpr bool reversed_polarity() const {
-        return base::check_bits(bits::polarity_status);
+        return base::get<fields::polarity_status>();
     }
 };
 
@@ -0,0 +1,409 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <enc28j60/device.hpp>
+#include <enc28j60/eth/address.hpp>
+#include <enc28j60/eth/register.hpp>
+#include <enc28j60/rx/status_vector.hpp>
+#include <enc28j60/spi/bus.hpp>
+#include <enc28j60/statistics.hpp>
+
+namespace enc28j60::rx {
+
+/**
+ * A received frame inside the buffer passed to ring::receive().
+ */
+struct packet {
+    std::uint8_t *data;
+    std::size_t size;
+    status_vector status;
+    
+    /**
+     * The frame did not fit into the buffer and was cut.
+     */
+    bool truncated;
+};
+
+/**
+ * Position of a received frame inside the receive ring.
+ */
+struct location {
+    /**
+     * First byte of the frame behind the ring header.
+     */
+    std::uint16_t start;
+    
+    /**
+     * Last byte of the frame without FCS, wrapped at the ring end.
+     */
+    std::uint16_t end;
+    
+    std::uint16_t size;
+    status_vector status;
+};
+
+/**
+ * Receive engine walking the receive ring between ERXST and ERXND.
+ *
+ * Frames are read straight into a caller supplied buffer, the
+ * frame check sequence is not transferred.
+ */
+class ring {
+public:
+    static constexpr std::uint8_t header_size = 2 + status_vector::size;
+    static constexpr std::uint8_t fcs_size = 4;
+    
+    /**
+     * `start` and `end` are the inclusive limits of the ring,
+     * `end` has to be odd.
+     */
+    ring(device &dev, std::uint16_t start, std::uint16_t end)
+        : device_(dev), start_(start), end_(end), next_(start) {}
+        
+    /**
+     * Programs the ring limits and discards the frames still
+     * counted in EPKTCNT. Reception has to be disabled.
+     */
+    void init() {
+        device_.write_pair(eth::address::erxstl, start_);
+        device_.write_pair(eth::address::erxndl, end_);
+        next_ = start_;
+        release(next_);
+        device_.read_pointer(next_);
+        for (std::uint8_t count = device_.read(eth::address::epktcnt);
+             count; --count) {
+            decrement();
+        }
+    }
+    
+    /**
+     * Number of frames waiting in the ring (EPKTCNT).
+     */
+    std::uint8_t pending() {
+        const std::uint8_t count = device_.read(eth::address::epktcnt);
+        device_.stats().rx_pending_high_water.update(count);
+        return count;
+    }
+    
+    /**
+     * Reads the header of the next frame without transferring the
+     * frame itself. Requires pending() to be non-zero.
+     *
+     * Returns std::nullopt if the ring header is corrupted or the
+     * bus failed(), in which case the receiver has to be reset and
+     * init() called again.
+     */
+    std::optional<location> peek() {
+        device_.read_pointer(next_);
+        std::array<std::uint8_t, header_size> header;
+        device_.read_buffer(header.data(), header.size());
+        const std::uint16_t start = advance(next_, header_size);
+        
+        const std::uint16_t next = next_pointer(header.data());
+        const status_vector status = header_status(header.data());
+        if (device_.failed()) {
+            return std::nullopt;
+        }
+            
+        if (!valid(next, status)) {
+            device_.stats().rx_ring_errors.add();
+            return std::nullopt;
+        }
+        
+        const std::uint16_t length = frame_length(status);
+        device_.assume_read_pointer(start);
+        const std::uint16_t end = advance(start, length ? length - 1u : 0u);
+        peeked_ = next;
+        peeked_size_ = length;
+        peeked_status_ = status;
+        return location{start, end, length, status};
+    }
+        
+    /**
+     * Releases the frame returned by the last peek().
+     */
+    void skip() {
+        const spi::batch batch(device_.bus());
+        next_ = peeked_;
+        release(next_);
+        decrement();
+        count(peeked_size_, peeked_status_);
+    }
+                         
+    /**
+     * Reads the next frame into `buffer` and releases its ring
+     * space. Requires pending() to be non-zero.
+     *
+     * Returns std::nullopt if the ring header is corrupted or the
+     * bus failed(), in which case the receiver has to be reset and
+     * init() called again.
+     */
+    std::optional<packet> receive(std::uint8_t *buffer, std::size_t size) {
+        const statistics::timer timer(device_.stats().rx_latency);
+        const std::optional<location> frame = peek();
+        if (!frame) {
+            return std::nullopt;
+        }
+        
+        // FCS and pad of a complete frame are clocked out with it,
+        // leaving ERDPT at the next header for the next peek()
+        const std::size_t copied = std::min<std::size_t>(frame->size, size);
+        const std::uint16_t end = advance(frame->start, copied);
+        std::uint16_t tail = distance(end, peeked_);
+        if (copied < frame->size || tail > fcs_size + 1) {
+            tail = 0;
+        }
+        device_.read_buffer(buffer, copied, tail);
+        device_.assume_read_pointer(advance(end, tail));
+        skip();
+        if (device_.failed()) {
+            return std::nullopt;
+        }
+        
+        if (copied < frame->size) {
+            device_.stats().rx_truncated.add();
+        }
+        
+        return packet{buffer, copied, frame->status, copied < frame->size};
+    }
+    
+    /**
+     * Reads as many of the next `max_packets` frames as lie back to
+     * back in the ring with a single buffer read into `buffer`,
+     * then releases them with one ERXRDPT update. `packets` receives
+     * views into `buffer`, which also holds the ring headers and
+     * FCS. Requires pending() to be at least `max_packets`.
+     *
+     * A run ends at ERXWRPT, at the end of `buffer` or at the
+     * largest transaction the bus carries. The read is also capped
+     * at `max_packets` frames of `max_frame_length` (MAMXFL) bytes,
+     * so a small `max_packets` does not pull in the rest of a full
+     * ring. If not even the first frame is complete, the rest of it
+     * is read behind the run, truncated to `buffer` like receive().
+     *
+     * Returns the number of frames read, zero if the ring header
+     * is corrupted or the bus failed(), in which case the receiver
+     * has to be reset and init() called again, or if `buffer` is
+     * too small for a ring header.
+     */
+    std::size_t receive_burst(std::uint8_t *buffer, std::size_t size,
+                              packet *packets, std::size_t max_packets,
+                              std::uint16_t max_frame_length = 1518) {
+        if (!max_packets || size < header_size) {
+            return 0;
+        }
+        
+        const statistics::timer timer(device_.stats().rx_latency);
+        const spi::batch batch(device_.bus());
+        const std::optional<std::size_t> frames =
+            read_run(buffer, size, packets, max_packets, max_frame_length);
+        return frames ? *frames : 0;
+    }
+    
+    std::uint16_t start() const {
+        return start_;
+    }
+    
+    std::uint16_t end() const {
+        return end_;
+    }
+    
+    /**
+     * Address of the next frame header.
+     */
+    std::uint16_t next() const {
+        return next_;
+    }
+    
+    std::uint16_t size() const {
+        return static_cast<std::uint16_t>(end_ - start_ + 1);
+    }
+    
+    /**
+     * Bytes of the ring occupied by frames not read yet, from
+     * ERXWRPT and the position of the next frame.
+     */
+    std::uint16_t used() {
+        const std::uint16_t write = device_.read_pair(eth::address::erxwrptl);
+        return static_cast<std::uint16_t>((write + size() - next_) % size());
+    }
+    
+private:
+    bool valid(std::uint16_t next, status_vector status) const {
+        return next >= start_ && next <= end_ && !(next & 1) &&
+               status.byte_count() <= size();
+    }
+    
+    /**
+     * The reading part of receive_burst(), std::nullopt for a
+     * corrupted header or a failed bus. Offsets into `buffer` are
+     * distances from next_, RBM wraps from ERXND to ERXST just like
+     * distance() does.
+     */
+    std::optional<std::size_t> read_run(std::uint8_t *buffer, std::size_t size,
+                                        packet *packets,
+                                        std::size_t max_packets,
+                                        std::uint16_t max_frame_length) {
+        const std::uint16_t write = device_.read_pair(eth::address::erxwrptl);
+        // every frame is followed by at most one pad byte
+        const std::size_t run =
+            max_packets * (header_size + max_frame_length + 1u);
+        const std::size_t bytes = std::min(
+            {std::size_t{distance(next_, write)}, size, run, max_read()});
+        if (bytes < header_size) {
+            return 0;
+        }
+        if (!read(buffer, 0, bytes)) {
+            return std::nullopt;
+        }
+        
+        std::size_t frames = 0;
+        std::size_t offset = 0;
+        while (frames < max_packets && offset + header_size <= bytes) {
+            const std::uint8_t *header = buffer + offset;
+            const std::uint16_t next = next_pointer(header);
+            const status_vector status = header_status(header);
+            if (!valid(next, status)) {
+                if (!frames) {
+                    device_.stats().rx_ring_errors.add();
+                    return std::nullopt;
+                }
+                break;
+            }
+            
+            const std::size_t end = distance(next_, next);
+            const std::uint16_t length = frame_length(status);
+            if (end <= offset || (end > bytes && frames)) {
+                break;
+            }
+            
+            if (end > bytes) {
+                // everything read so far belongs to the first frame,
+                // fetch the rest of it up to the end of `buffer`
+                const std::size_t available = std::min(end, size);
+                if (!read(buffer, bytes, available)) {
+                    return std::nullopt;
+                }
+                
+                const std::size_t copied =
+                    std::min<std::size_t>(length, available - header_size);
+                if (copied < length) {
+                    device_.stats().rx_truncated.add();
+                }
+                packets[frames++] = packet{buffer + header_size, copied,
+                                           status, copied < length};
+                count(length, status);
+                offset = end;
+                break;
+            }
+            
+            packets[frames++] = packet{buffer + offset + header_size, length,
+                                       status, false};
+            count(length, status);
+            offset = end;
+        }
+        
+        if (frames) {
+            next_ = advance(next_, offset);
+            release(next_);
+            for (std::size_t i = 0; i < frames; ++i) {
+                decrement();
+            }
+        }
+        return frames;
+    }
+    
+    /**
+     * Largest buffer read the bus carries, without the opcode.
+     */
+    std::size_t max_read() const {
+        return std::max<std::size_t>(device_.bus().max_transfer(), 2) - 1;
+    }
+    
+    /**
+     * Reads the ring bytes at distances [from, to) from next_ into
+     * the same offsets of `buffer`.
+     */
+    bool read(std::uint8_t *buffer, std::size_t from, std::size_t to) {
+        device_.read_pointer(advance(next_, from));
+        while (from < to) {
+            const std::size_t n = std::min(to - from, max_read());
+            device_.read_buffer(buffer + from, n);
+            from += n;
+            device_.assume_read_pointer(advance(next_, from));
+        }
+        return !device_.failed();
+    }
+    
+    static std::uint16_t next_pointer(const std::uint8_t *header) {
+        return header[0] | header[1] << 8;
+    }
+    
+    static status_vector header_status(const std::uint8_t *header) {
+        return status_vector(
+            static_cast<std::uint32_t>(header[2]) |
+            static_cast<std::uint32_t>(header[3]) << 8 |
+            static_cast<std::uint32_t>(header[4]) << 16 |
+            static_cast<std::uint32_t>(header[5]) << 24);
+    }
+    
+    /**
+     * Frame length without FCS.
+     */
+    static std::uint16_t frame_length(status_vector status) {
+        return static_cast<std::uint16_t>(
+            std::max<std::uint16_t>(status.byte_count(), fcs_size) - fcs_size);
+    }
+    
+    std::uint16_t advance(std::uint16_t pointer, std::size_t count) const {
+        const std::size_t offset = (pointer - start_ + count) % size();
+        return static_cast<std::uint16_t>(start_ + offset);
+    }
+    
+    /**
+     * Bytes from `from` up to `to`, wrapping at the ring end.
+     */
+    std::uint16_t distance(std::uint16_t from, std::uint16_t to) const {
+        return static_cast<std::uint16_t>((to + size() - from) % size());
+    }
+    
+    /**
+     * Frees the ring up to `next`. ERXRDPT must always be odd
+     * (silicon errata), so it is set to the byte in front of it.
+     */
+    void release(std::uint16_t next) {
+        const std::uint16_t pointer = next == start_ ? end_ : next - 1;
+        device_.write_pair(eth::address::erxrdptl, pointer);
+    }
+    
+    void decrement() {
+        device_.set_bits(eth::address::econ2,
+                         eth::control_register_2(0).packet_decrement(true).data());
+    }
+    
+    void count(std::uint16_t size, status_vector status) {
+        statistics &stats = device_.stats();
+        stats.rx_frames.add();
+        stats.rx_bytes.add(size);
+        if (status.crc_error()) {
+            stats.rx_crc_errors.add();
+        }
+        if (status.length_check_error() || status.length_out_of_range()) {
+            stats.rx_length_errors.add();
+        }
+    }
+    
+    device &device_;
+    std::uint16_t start_;
+    std::uint16_t end_;
+    std::uint16_t next_;
+    std::uint16_t peeked_ = 0;
+    std::uint16_t peeked_size_ = 0;
+    status_vector peeked_status_;
+};
+
+}
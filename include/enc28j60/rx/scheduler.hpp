@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <enc28j60/device.hpp>
+#include <enc28j60/eth/address.hpp>
+#include <enc28j60/eth/register.hpp>
+#include <enc28j60/rx/ring.hpp>
+#include <enc28j60/spi/bus.hpp>
+#include <enc28j60/statistics.hpp>
+
+namespace enc28j60::rx {
+
+/**
+ * Mode switch thresholds of the receive scheduler.
+ */
+struct scheduler_options {
+    /**
+     * EPKTCNT found on a receive interrupt from which the scheduler
+     * switches to polling.
+     */
+    std::uint8_t polling_threshold = 4;
+    
+    /**
+     * Frames drained per polling pass at most.
+     */
+    std::size_t budget = 16;
+    
+    /**
+     * Frames are drained in bursts of back to back frames through a
+     * buffer of `burst_size` bytes, or `max_frame_length` if that is
+     * larger. The default keeps a whole burst read, opcode included,
+     * within the 4096 byte default buffer of spidev.
+     */
+    std::size_t max_frame_length = 1518;
+    std::size_t burst_size = 4095;
+};
+
+/**
+ * Receive scheduler switching between interrupts and polling, like
+ * NAPI.
+ *
+ * Under light load every PKTIF interrupt drains the frames found in
+ * EPKTCNT. Once an interrupt finds `polling_threshold` frames or
+ * more, EIE.PKTIE is masked and the owner calls poll() until it
+ * returns false: every pass drains up to `budget` frames, sized by
+ * one EPKTCNT read, in a single SPI batch. Frames lying back to
+ * back in the ring are read with a single buffer read. A pass that finds the
+ * ring empty unmasks PKTIE again, which raises the line right away
+ * if a frame slipped in. This bounds the interrupt rate under a
+ * broadcast storm and leaves the owner room for other work between
+ * passes.
+ */
+class scheduler {
+public:
+    using frame_handler = std::function<void(const packet &packet)>;
+    
+    enum class mode {
+        interrupt,
+        polling
+    };
+    
+    scheduler(device &dev, ring &ring)
+        : scheduler(dev, ring, scheduler_options()) {}
+    
+    scheduler(device &dev, ring &ring, const scheduler_options &options)
+        : device_(dev), ring_(ring) {
+        configure(options);
+    }
+    
+    void on_frame(frame_handler handler) {
+        frame_ = std::move(handler);
+    }
+    
+    /**
+     * Changes the thresholds, takes effect with the next interrupt
+     * or pass.
+     */
+    void configure(const scheduler_options &options) {
+        options_ = options;
+        buffer_.resize(std::max(options.max_frame_length, options.burst_size));
+        packets_.resize(std::max<std::size_t>(options.budget, 1));
+        
+        statistics &stats = device_.stats();
+        stats.rx_polling_threshold.set(options.polling_threshold);
+        stats.rx_poll_budget.set(options.budget);
+    }
+    
+    const scheduler_options &options() const {
+        return options_;
+    }
+    
+    mode current_mode() const {
+        return mode_;
+    }
+    
+    /**
+     * To be called on PKTIF, typically from the receive handler of
+     * the interrupt dispatcher. Returns true if the scheduler
+     * switched to polling.
+     */
+    bool interrupt() {
+        if (mode_ == mode::polling) {
+            return false;
+        }
+        
+        const std::uint8_t pending = ring_.pending();
+        if (pending < options_.polling_threshold) {
+            const spi::batch batch(device_.bus());
+            drain(pending);
+            return false;
+        }
+        
+        device_.clear_bits(eth::address::eie, packet_interrupt);
+        mode_ = mode::polling;
+        
+        statistics &stats = device_.stats();
+        stats.rx_polling.set(1);
+        stats.rx_polling_entered.add();
+        return true;
+    }
+    
+    /**
+     * One polling pass. Returns true while more passes are needed,
+     * false once the scheduler is back in interrupt mode.
+     */
+    bool poll() {
+        if (mode_ == mode::interrupt) {
+            return false;
+        }
+        
+        statistics &stats = device_.stats();
+        stats.rx_poll_passes.add();
+        
+        const spi::batch batch(device_.bus());
+        const std::uint8_t pending = ring_.pending();
+        if (!pending) {
+            device_.set_bits(eth::address::eie, packet_interrupt);
+            mode_ = mode::interrupt;
+            stats.rx_polling.set(0);
+            stats.rx_polling_left.add();
+            return false;
+        }
+        
+        if (pending > options_.budget) {
+            stats.rx_budget_exhausted.add();
+        }
+        drain(std::min<std::size_t>(pending, options_.budget));
+        return true;
+    }
+    
+private:
+    static constexpr std::uint8_t packet_interrupt =
+        eth::interrupt_enable(0).receive(true).data();
+    
+    void drain(std::size_t count) {
+        while (count) {
+            const std::size_t frames = ring_.receive_burst(
+                buffer_.data(), buffer_.size(), packets_.data(),
+                std::min(count, packets_.size()),
+                static_cast<std::uint16_t>(options_.max_frame_length));
+            if (!frames) {
+                // corrupted ring, the owner has to reinitialise it
+                return;
+            }
+            
+            if (frame_) {
+                for (std::size_t i = 0; i < frames; ++i) {
+                    frame_(packets_[i]);
+                }
+            }
+            count -= frames;
+        }
+    }
+    
+    device &device_;
+    ring &ring_;
+    scheduler_options options_;
+    std::vector<std::uint8_t> buffer_;
+    std::vector<packet> packets_;
+    frame_handler frame_;
+    mode mode_ = mode::interrupt;
+};
+
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <enc28j60/detail/base_register.hpp>
+
+namespace enc28j60::rx {
+
+/**
+ * Receive status vector written by the device in front of every
+ * received frame.
+ */
+class status_vector : public base_register<std::uint32_t> {
+    using base = base_register<std::uint32_t>;
+    
+    struct fields {
+        using byte_count = base::field<0x0000ffff, std::uint16_t>;
+        using long_event = base::field<0x00010000>;
+        using carrier_event = base::field<0x00040000>;
+        using crc_error = base::field<0x00100000>;
+        using length_check_error = base::field<0x00200000>;
+        using length_out_of_range = base::field<0x00400000>;
+        using received_ok = base::field<0x00800000>;
+        using multicast = base::field<0x01000000>;
+        using broadcast = base::field<0x02000000>;
+        using dribble_nibble = base::field<0x04000000>;
+        using control_frame = base::field<0x08000000>;
+        using pause_control_frame = base::field<0x10000000>;
+        using unknown_opcode = base::field<0x20000000>;
+        using vlan = base::field<0x40000000>;
+    };
+    
+    static_assert(disjoint<fields::byte_count, fields::long_event,
+                           fields::carrier_event, fields::crc_error,
+                           fields::length_check_error,
+                           fields::length_out_of_range, fields::received_ok,
+                           fields::multicast, fields::broadcast,
+                           fields::dribble_nibble, fields::control_frame,
+                           fields::pause_control_frame,
+                           fields::unknown_opcode, fields::vlan>());
+    
+public:
+    static constexpr std::uint8_t size = 4;
+    
+    constexpr status_vector() = default;
+    
+    constexpr status_vector(std::uint32_t data) : base(data) {}
+    
+    /**
+     * Length of the received frame including destination address,
+     * source address, type/length, data, padding and CRC.
+     */
+    constexpr std::uint16_t byte_count() const {
+        return base::get<fields::byte_count>();
+    }
+    
+    /**
+     * A packet over 50000 bit times occurred or a previous
+     * packet was dropped.
+     */
+    constexpr bool long_event() const {
+        return base::get<fields::long_event>();
+    }
+    
+    constexpr bool carrier_event() const {
+        return base::get<fields::carrier_event>();
+    }
+    
+    constexpr bool crc_error() const {
+        return base::get<fields::crc_error>();
+    }
+    
+    constexpr bool length_check_error() const {
+        return base::get<fields::length_check_error>();
+    }
+    
+    constexpr bool length_out_of_range() const {
+        return base::get<fields::length_out_of_range>();
+    }
+    
+    constexpr bool received_ok() const {
+        return base::get<fields::received_ok>();
+    }
+    
+    constexpr bool multicast() const {
+        return base::get<fields::multicast>();
+    }
+    
+    constexpr bool broadcast() const {
+        return base::get<fields::broadcast>();
+    }
+    
+    constexpr bool dribble_nibble() const {
+        return base::get<fields::dribble_nibble>();
+    }
+    
+    constexpr bool control_frame() const {
+        return base::get<fields::control_frame>();
+    }
+    
+    constexpr bool pause_control_frame() const {
+        return base::get<fields::pause_control_frame>();
+    }
+    
+    constexpr bool unknown_opcode() const {
+        return base::get<fields::unknown_opcode>();
+    }
+    
+    constexpr bool vlan() const {
+        return base::get<fields::vlan>();
+    }
+};
+
+}
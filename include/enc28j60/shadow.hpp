@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <enc28j60/device.hpp>
+
+namespace enc28j60 {
+
+/**
+ * Keeps the last known value of a register and writes only the
+ * difference to a new value.
+ *
+ * ETH registers that only gain or only lose bits are updated with a
+ * single bit field set or clear command, every other change is one
+ * write. Unchanged values cause no bus traffic at all.
+ *
+ * Only suitable for registers the device does not modify on its
+ * own, like MACON1-4 or ERXFCON.
+ */
+template<typename Register>
+class shadow {
+    static_assert(sizeof(typename Register::native_type) == 1,
+                  "Only 8 bit registers are directly accessible.");
+                  
+public:
+    explicit shadow(device &dev) : device_(dev) {}
+    
+    /**
+     * Reads the register to initialise the shadow copy.
+     */
+    const Register &load() {
+        assume(device_.read<Register>());
+        return value_;
+    }
+    
+    /**
+     * Sets the shadow copy without bus access, for example to the
+     * reset value after a system reset.
+     */
+    void assume(const Register &value) {
+        value_ = value;
+        valid_ = true;
+    }
+    
+    /**
+     * Forgets the shadow copy. The next store() writes the whole
+     * register.
+     */
+    void invalidate() {
+        valid_ = false;
+    }
+    
+    void store(const Register &value) {
+        if (!valid_) {
+            device_.write(value);
+            assume(value);
+            return;
+        }
+        
+        const std::uint8_t last = value_.data();
+        const std::uint8_t next = value.data();
+        const std::uint8_t set = next & ~last;
+        const std::uint8_t clear = last & ~next;
+        
+        // bits going both ways take one write instead of BFS and BFC
+        if (Register::address.bit_field_operations() && !(set && clear)) {
+            if (set) {
+                device_.set_bits(Register::address, set);
+            }
+            if (clear) {
+                device_.clear_bits(Register::address, clear);
+            }
+        } else if (set | clear) {
+            device_.write(value);
+        }
+        value_ = value;
+    }
+    
+    /**
+     * Applies `f` to a copy of the shadowed value and stores the
+     * result.
+     */
+    template<typename Function>
+    void modify(Function &&f) {
+        Register value = value_;
+        f(value);
+        store(value);
+    }
+    
+    const Register &value() const {
+        return value_;
+    }
+    
+    bool valid() const {
+        return valid_;
+    }
+    
+private:
+    device &device_;
+    Register value_{};
+    bool valid_ = false;
+};
+
+}
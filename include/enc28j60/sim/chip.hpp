@@ -0,0 +1,1109 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <enc28j60/crc/crc32.hpp>
+#include <enc28j60/detail/register_address.hpp>
+#include <enc28j60/eth/address.hpp>
+#include <enc28j60/filter/hash_table.hpp>
+#include <enc28j60/mac/address.hpp>
+#include <enc28j60/phy/address.hpp>
+#include <enc28j60/spi/bus.hpp>
+#include <enc28j60/spi/opcode.hpp>
+
+namespace enc28j60::sim {
+
+/**
+ * Behavioural model of an ENC28J60 attached to the SPI bus.
+ *
+ * Models the four control register banks, the 8 KB buffer
+ * memory, the receive ring, the transmit logic and indirect PHY
+ * access through the MII registers. Frames are exchanged with
+ * the host through receive() and the transmit handler.
+ */
+class chip : public spi::bus {
+public:
+    static constexpr std::size_t buffer_size = 0x2000;
+    
+    struct statistics {
+        std::uint64_t transactions = 0;
+        std::uint64_t bytes = 0;
+        
+        /**
+         * Commands the real device would not accept, like bit
+         * field operations on MAC registers.
+         */
+        std::uint64_t invalid_commands = 0;
+        
+        std::uint64_t received_frames = 0;
+        std::uint64_t dropped_frames = 0;
+        
+        /**
+         * Dropped frames that set EIR.RXERIF because the ring or
+         * EPKTCNT was full, also counted in dropped_frames.
+         */
+        std::uint64_t overflowed_frames = 0;
+        
+        /**
+         * Frames rejected by the ERXFCON receive filters.
+         */
+        std::uint64_t filtered_frames = 0;
+        std::uint64_t transmitted_frames = 0;
+        
+        /**
+         * Transmissions aborted by an injected late collision.
+         */
+        std::uint64_t aborted_frames = 0;
+        
+        /**
+         * PAUSE frames requested through EFLOCON in full duplex,
+         * periodic mode counts once.
+         */
+        std::uint64_t pause_frames = 0;
+    };
+    
+    using transmit_handler =
+        std::function<void(const std::uint8_t *frame, std::size_t size)>;
+    using interrupt_handler = std::function<void()>;
+        
+    chip() {
+        reset();
+    }
+    
+    void transfer(const spi::segment *segments, std::size_t count) override {
+        ++stats_.transactions;
+        tick();
+        
+        index_ = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const spi::segment &s = segments[i];
+            for (std::size_t j = 0; j < s.size; ++j) {
+                const std::uint8_t out = clock(s.tx ? s.tx[j] : 0);
+                if (s.rx) {
+                    s.rx[j] = out;
+                }
+            }
+            stats_.bytes += s.size;
+        }
+        update_interrupt();
+    }
+    
+    /**
+     * Returns the device to its power-on state. Buffer memory
+     * and statistics are left untouched.
+     */
+    void reset() {
+        registers_.fill(0);
+        
+        reg(eth::address::econ2) = econ2::autoinc;
+        reg(eth::address::estat) = estat::clkrdy;
+        pair(eth::address::erdptl, 0x05fa);
+        pair(eth::address::erxstl, 0x05fa);
+        pair(eth::address::erxndl, 0x1fff);
+        pair(eth::address::erxrdptl, 0x05fa);
+        reg(eth::address::erxfcon) = 0xa1;
+        reg(eth::address::erevid) = 0x06;
+        reg(eth::address::ecocon) = 0x04;
+        pair(eth::address::epausl, 0x1000);
+        pair(mac::address::mamxfll, 0x0600);
+        
+        phy_.fill(0);
+        phy_[phy::address::phstat1.address] = 0x1800;
+        phy_[phy::address::phid1.address] = 0x0083;
+        phy_[phy::address::phid2.address] = 0x1400;
+        phy_[phy::address::phlcon.address] = 0x3422;
+        link(link_);
+        
+        mii_operation_ = mii_operation::none;
+        mii_countdown_ = 0;
+        tx_countdown_ = 0;
+        tx_pending_ = false;
+        tx_stalled_ = false;
+    }
+    
+    /**
+     * Places a frame received from the wire into the receive
+     * ring. The frame check sequence is appended by the model.
+     * Returns false if the frame was dropped.
+     */
+    bool receive(const std::uint8_t *frame, std::size_t size) {
+        const std::size_t length = size + fcs_size;
+        const std::size_t needed = header_size + length + (length & 1);
+        
+        if (!(reg(eth::address::econ1) & econ1::rxen) ||
+            (reg(eth::address::econ1) & econ1::rxrst)) {
+            ++stats_.dropped_frames;
+            return false;
+        }
+        
+        if (!accept(frame, size)) {
+            ++stats_.filtered_frames;
+            return false;
+        }
+        
+        if (needed > rx_free_space() ||
+            reg(eth::address::epktcnt) == 0xff) {
+            reg(eth::address::eir) |= eir::rxerif;
+            ++stats_.dropped_frames;
+            ++stats_.overflowed_frames;
+            update_interrupt();
+            return false;
+        }
+        
+        std::uint16_t pointer = pair(eth::address::erxwrptl);
+        std::uint16_t next = pointer;
+        for (std::size_t i = 0; i < needed; ++i) {
+            next = rx_increment(next);
+        }
+        
+        const std::uint32_t status = receive_status(frame, size);
+        const std::array<std::uint8_t, header_size> header{
+            static_cast<std::uint8_t>(next),
+            static_cast<std::uint8_t>(next >> 8),
+            static_cast<std::uint8_t>(length),
+            static_cast<std::uint8_t>(length >> 8),
+            static_cast<std::uint8_t>(status),
+            static_cast<std::uint8_t>(status >> 8)};
+            
+        for (std::uint8_t b : header) {
+            pointer = rx_store(pointer, b);
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            pointer = rx_store(pointer, frame[i]);
+        }
+        const std::uint32_t fcs = crc::compute(frame, size);
+        for (std::size_t i = 0; i < fcs_size; ++i) {
+            pointer = rx_store(pointer, static_cast<std::uint8_t>(fcs >> (8 * i)));
+        }
+        
+        pair(eth::address::erxwrptl, next);
+        ++reg(eth::address::epktcnt);
+        reg(eth::address::eir) |= eir::pktif;
+        ++stats_.received_frames;
+        update_interrupt();
+        return true;
+    }
+    
+    /**
+     * Changes the link state reported by PHSTAT1 and PHSTAT2 and
+     * raises the PHY link change interrupt.
+     */
+    void link(bool up) {
+        const bool changed = up != link_;
+        link_ = up;
+        
+        auto &status1 = phy_[phy::address::phstat1.address];
+        auto &status2 = phy_[phy::address::phstat2.address];
+        if (up) {
+            status2 |= phstat2::lstat;
+        } else {
+            status1 &= ~phstat1::llstat;
+            status2 &= ~phstat2::lstat;
+        }
+        
+        if (changed) {
+            phy_interrupt();
+            update_interrupt();
+        }
+    }
+    
+    bool link() const {
+        return link_;
+    }
+    
+    void on_transmit(transmit_handler handler) {
+        transmit_handler_ = std::move(handler);
+    }
+    
+    /**
+     * Called whenever the INT pin gets asserted, like a falling
+     * edge interrupt on the host.
+     */
+    void on_interrupt(interrupt_handler handler) {
+        interrupt_handler_ = std::move(handler);
+    }
+    
+    /**
+     * Number of transactions an MII operation keeps MISTAT.BUSY
+     * set. Models the 10.24 us the real device needs.
+     */
+    void mii_latency(unsigned transactions) {
+        mii_latency_ = transactions;
+    }
+    
+    /**
+     * Number of transactions a transmission keeps ECON1.TXRTS
+     * set. Zero completes transmissions immediately.
+     */
+    void transmit_latency(unsigned transactions) {
+        tx_latency_ = transactions;
+    }
+    
+    /**
+     * Aborts the next `count` transmissions with a late collision.
+     * Like the real device in half duplex mode (silicon errata),
+     * the transmit logic then stalls: the next transmission never
+     * completes unless ECON1.TXRST was pulsed before.
+     */
+    void late_collisions(unsigned count) {
+        late_collisions_ = count;
+    }
+    
+    /**
+     * State of the active low INT pin, true if asserted.
+     */
+    bool interrupt() const {
+        const std::uint8_t enabled = reg(eth::address::eie);
+        return (enabled & eie::intie) &&
+               (enabled & reg(eth::address::eir) & eir::all);
+    }
+    
+    std::uint8_t register_value(register_address address) const {
+        if (address.kind == register_kind::phy) {
+            return static_cast<std::uint8_t>(phy_[address.address]);
+        }
+        return reg(address);
+    }
+    
+    std::uint16_t phy_register(register_address address) const {
+        return phy_[address.address];
+    }
+    
+    void phy_register(register_address address, std::uint16_t value) {
+        phy_[address.address] = value;
+    }
+    
+    std::uint8_t *memory() {
+        return memory_.data();
+    }
+    
+    const std::uint8_t *memory() const {
+        return memory_.data();
+    }
+    
+    const statistics &stats() const {
+        return stats_;
+    }
+    
+    void reset_stats() {
+        stats_ = statistics{};
+    }
+    
+private:
+    static constexpr std::size_t header_size = 6;
+    static constexpr std::size_t fcs_size = 4;
+    static constexpr std::size_t tsv_size = 7;
+    static constexpr std::uint16_t address_mask = buffer_size - 1;
+    
+    struct econ1 {
+        enum : std::uint8_t {
+            txrst = 0x80,
+            rxrst = 0x40,
+            dmast = 0x20,
+            csumen = 0x10,
+            txrts = 0x08,
+            rxen = 0x04,
+            bsel = 0x03
+        };
+    };
+    
+    struct econ2 {
+        enum : std::uint8_t {
+            autoinc = 0x80,
+            pktdec = 0x40
+        };
+    };
+    
+    struct estat {
+        enum : std::uint8_t {
+            latecol = 0x10,
+            txabrt = 0x02,
+            clkrdy = 0x01
+        };
+    };
+    
+    struct eie {
+        enum : std::uint8_t {
+            intie = 0x80
+        };
+    };
+    
+    struct eir {
+        enum : std::uint8_t {
+            pktif = 0x40,
+            dmaif = 0x20,
+            linkif = 0x10,
+            txif = 0x08,
+            txerif = 0x02,
+            rxerif = 0x01,
+            all = 0x7b
+        };
+    };
+    
+    struct erxfcon {
+        enum : std::uint8_t {
+            ucen = 0x80,
+            andor = 0x40,
+            crcen = 0x20,
+            pmen = 0x10,
+            mpen = 0x08,
+            hten = 0x04,
+            mcen = 0x02,
+            bcen = 0x01
+        };
+    };
+    
+    struct micmd {
+        enum : std::uint8_t {
+            miiscan = 0x02,
+            miird = 0x01
+        };
+    };
+    
+    struct mistat {
+        enum : std::uint8_t {
+            nvalid = 0x04,
+            scan = 0x02,
+            busy = 0x01
+        };
+    };
+    
+    struct macon3 {
+        enum : std::uint8_t {
+            padcfg = 0xe0,
+            pad_60_vlan_64 = 0xa0,
+            pad_64 = 0x60,
+            pad_60 = 0x20,
+            txcrcen = 0x10,
+            fulldpx = 0x01
+        };
+    };
+    
+    struct eflocon {
+        enum : std::uint8_t {
+            fuldpxs = 0x04,
+            fcen = 0x03,
+            pause_periodic = 0x02
+        };
+    };
+    
+    struct control_byte {
+        enum : std::uint8_t {
+            phugeen = 0x08,
+            ppaden = 0x04,
+            pcrcen = 0x02,
+            poverride = 0x01
+        };
+    };
+    
+    struct phstat1 {
+        enum : std::uint16_t {
+            llstat = 0x0004
+        };
+    };
+    
+    struct phstat2 {
+        enum : std::uint16_t {
+            lstat = 0x0400
+        };
+    };
+    
+    struct phcon1 {
+        enum : std::uint16_t {
+            prst = 0x8000
+        };
+    };
+    
+    struct phy_interrupt_bits {
+        enum : std::uint16_t {
+            link = 0x0010,
+            global_flag = 0x0004,
+            global_enable = 0x0002
+        };
+    };
+    
+    enum class mii_operation {
+        none,
+        read,
+        write
+    };
+    
+    static std::size_t index(std::uint8_t bank, std::uint8_t address) {
+        return address >= 0x1b ? address : bank * 0x20u + address;
+    }
+    
+    static std::size_t index(register_address address) {
+        return index(static_cast<std::uint8_t>(address.bank) & 0x03,
+                     address.address);
+    }
+    
+    std::uint8_t &reg(register_address address) {
+        return registers_[index(address)];
+    }
+    
+    std::uint8_t reg(register_address address) const {
+        return registers_[index(address)];
+    }
+    
+    std::uint16_t pair(register_address low) const {
+        return reg(low) | reg(low.high()) << 8;
+    }
+    
+    void pair(register_address low, std::uint16_t value) {
+        reg(low) = static_cast<std::uint8_t>(value);
+        reg(low.high()) = static_cast<std::uint8_t>(value >> 8);
+    }
+    
+    std::uint8_t selected_bank() const {
+        return reg(eth::address::econ1) & econ1::bsel;
+    }
+    
+    static register_kind kind(std::uint8_t bank, std::uint8_t address) {
+        if (address >= 0x1b) {
+            return register_kind::eth;
+        }
+        if (bank == 2) {
+            if (address <= 0x0d) {
+                return register_kind::mac;
+            }
+            if (address >= 0x12 && address <= 0x19) {
+                return register_kind::mii;
+            }
+        }
+        if (bank == 3) {
+            if (address <= 0x05) {
+                return register_kind::mac;
+            }
+            if (address == 0x0a) {
+                return register_kind::mii;
+            }
+        }
+        return register_kind::eth;
+    }
+    
+    std::uint8_t clock(std::uint8_t in) {
+        const std::size_t position = index_++;
+        if (position == 0) {
+            command_ = in;
+            if (in == spi::encode(spi::opcode::system_reset,
+                                  spi::argument::system_reset)) {
+                reset();
+            }
+            return 0;
+        }
+        
+        const std::uint8_t argument = spi::decode_argument(command_);
+        const std::uint8_t bank = selected_bank();
+        const register_kind k = kind(bank, argument);
+        std::uint8_t &value = registers_[index(bank, argument)];
+        
+        switch (spi::decode_opcode(command_)) {
+        case spi::opcode::read_control_register:
+            if (k != register_kind::eth && position == 1) {
+                return 0;
+            }
+            return value;
+            
+        case spi::opcode::write_control_register:
+            if (position == 1) {
+                write(bank, argument, in);
+            }
+            return 0;
+            
+        case spi::opcode::bit_field_set:
+        case spi::opcode::bit_field_clear:
+            if (position == 1) {
+                if (k != register_kind::eth) {
+                    ++stats_.invalid_commands;
+                } else if (spi::decode_opcode(command_) ==
+                           spi::opcode::bit_field_set) {
+                    write(bank, argument, value | in);
+                } else {
+                    write(bank, argument, value & ~in);
+                }
+            }
+            return 0;
+            
+        case spi::opcode::read_buffer_memory:
+            if (argument != spi::argument::buffer_memory) {
+                ++stats_.invalid_commands;
+                return 0;
+            }
+            return read_buffer();
+            
+        case spi::opcode::write_buffer_memory:
+            if (argument != spi::argument::buffer_memory) {
+                ++stats_.invalid_commands;
+                return 0;
+            }
+            write_buffer(in);
+            return 0;
+            
+        case spi::opcode::system_reset:
+            return 0;
+        }
+        return 0;
+    }
+    
+    std::uint8_t read_buffer() {
+        std::uint16_t pointer = pair(eth::address::erdptl);
+        const std::uint8_t data = memory_[pointer];
+        
+        if (reg(eth::address::econ2) & econ2::autoinc) {
+            if (pointer == pair(eth::address::erxndl)) {
+                pointer = pair(eth::address::erxstl);
+            } else {
+                pointer = (pointer + 1) & address_mask;
+            }
+            pair(eth::address::erdptl, pointer);
+        }
+        return data;
+    }
+    
+    void write_buffer(std::uint8_t data) {
+        const std::uint16_t pointer = pair(eth::address::ewrptl);
+        memory_[pointer] = data;
+        
+        if (reg(eth::address::econ2) & econ2::autoinc) {
+            pair(eth::address::ewrptl, (pointer + 1) & address_mask);
+        }
+    }
+    
+    void write(std::uint8_t bank, std::uint8_t address, std::uint8_t value) {
+        const std::size_t i = index(bank, address);
+        const std::uint8_t old = registers_[i];
+        
+        if (address >= 0x1b) {
+            write_common(address, old, value);
+            return;
+        }
+        
+        switch (bank) {
+        case 0:
+            if (address == eth::address::erxwrptl.address ||
+                address == eth::address::erxwrpth.address) {
+                return;
+            }
+            // upper halves of buffer pointers are 5 bits wide
+            registers_[i] = address < eth::address::edmacsl.address &&
+                                    (address & 1) ? value & 0x1f : value;
+            if (address == eth::address::erxstl.address ||
+                address == eth::address::erxsth.address) {
+                pair(eth::address::erxwrptl, pair(eth::address::erxstl));
+            }
+            break;
+            
+        case 1:
+            if (address == eth::address::epktcnt.address) {
+                return;
+            }
+            registers_[i] = value;
+            break;
+            
+        case 2:
+            registers_[i] = value;
+            if (address == mac::address::macon3.address) {
+                write_eflocon(reg(eth::address::eflocon));
+            } else if (address == mac::address::micmd.address) {
+                write_micmd(old, value);
+            } else if (address == mac::address::miwrh.address) {
+                start_mii(mii_operation::write);
+            }
+            break;
+            
+        case 3:
+            if (address == mac::address::mistat.address ||
+                address == eth::address::erevid.address) {
+                return;
+            }
+            if (address == eth::address::eflocon.address) {
+                write_eflocon(value);
+                return;
+            }
+            registers_[i] = value;
+            break;
+        }
+    }
+    
+    void write_common(std::uint8_t address, std::uint8_t old, std::uint8_t value) {
+        std::uint8_t &r = registers_[address];
+        
+        if (address == eth::address::econ1.address) {
+            r = value;
+            if (value & econ1::txrst) {
+                tx_stalled_ = false;
+            }
+            if ((value & econ1::txrts) && !(old & econ1::txrts)) {
+                start_transmission();
+            } else if (!(value & econ1::txrts)) {
+                tx_pending_ = false;
+            }
+            if ((value & econ1::dmast) && !(old & econ1::dmast)) {
+                run_dma();
+            }
+        } else if (address == eth::address::econ2.address) {
+            r = value & ~econ2::pktdec;
+            if (value & econ2::pktdec) {
+                std::uint8_t &count = reg(eth::address::epktcnt);
+                if (count) {
+                    --count;
+                }
+                if (!count) {
+                    reg(eth::address::eir) &= ~eir::pktif;
+                }
+            }
+        } else if (address == eth::address::eir.address) {
+            r = (value & ~eir::pktif) | (old & eir::pktif);
+        } else if (address == eth::address::estat.address) {
+            r = (value & ~estat::clkrdy) | (old & estat::clkrdy);
+        } else {
+            r = value;
+        }
+    }
+    
+    /**
+     * FULDPXS follows MACON3.FULDPX. In full duplex the single
+     * PAUSE frame modes turn themselves off once sent.
+     */
+    void write_eflocon(std::uint8_t value) {
+        const bool full_duplex = reg(mac::address::macon3) & macon3::fulldpx;
+        std::uint8_t mode = value & eflocon::fcen;
+        
+        if (full_duplex && mode &&
+            mode != (reg(eth::address::eflocon) & eflocon::fcen)) {
+            ++stats_.pause_frames;
+            if (mode != eflocon::pause_periodic) {
+                mode = 0;
+            }
+        }
+        reg(eth::address::eflocon) = mode | (full_duplex ? eflocon::fuldpxs : 0);
+    }
+    
+    void write_micmd(std::uint8_t old, std::uint8_t value) {
+        std::uint8_t &status = reg(mac::address::mistat);
+        
+        if ((value & micmd::miird) && !(old & micmd::miird)) {
+            start_mii(mii_operation::read);
+        }
+        
+        if ((value & micmd::miiscan) && !(old & micmd::miiscan)) {
+            status |= mistat::scan | mistat::nvalid;
+            start_mii(mii_operation::read);
+        } else if (!(value & micmd::miiscan) && (old & micmd::miiscan)) {
+            status &= ~(mistat::scan | mistat::nvalid);
+        }
+    }
+    
+    void start_mii(mii_operation operation) {
+        mii_operation_ = operation;
+        mii_countdown_ = mii_latency_;
+        reg(mac::address::mistat) |= mistat::busy;
+        if (!mii_countdown_) {
+            complete_mii();
+        }
+    }
+    
+    void complete_mii() {
+        const std::uint8_t address = reg(mac::address::miregadr) & 0x1f;
+        std::uint8_t &status = reg(mac::address::mistat);
+        
+        if (mii_operation_ == mii_operation::read) {
+            pair(mac::address::mirdl, read_phy(address));
+            status &= ~mistat::nvalid;
+        } else if (mii_operation_ == mii_operation::write) {
+            write_phy(address, pair(mac::address::miwrl));
+        }
+        
+        mii_operation_ = mii_operation::none;
+        if (status & mistat::scan) {
+            // scanning keeps the interface busy and restarts the read
+            mii_operation_ = mii_operation::read;
+            mii_countdown_ = mii_latency_;
+        } else {
+            status &= ~mistat::busy;
+        }
+    }
+    
+    std::uint16_t read_phy(std::uint8_t address) {
+        const std::uint16_t value = phy_[address];
+        
+        if (address == phy::address::phstat1.address && link_) {
+            phy_[address] |= phstat1::llstat;
+        } else if (address == phy::address::phir.address) {
+            phy_[address] = 0;
+            reg(eth::address::eir) &= ~eir::linkif;
+        }
+        return value;
+    }
+    
+    void write_phy(std::uint8_t address, std::uint16_t value) {
+        if (address == phy::address::phcon1.address && (value & phcon1::prst)) {
+            value &= ~phcon1::prst;
+        }
+        if (address == phy::address::phstat1.address ||
+            address == phy::address::phstat2.address ||
+            address == phy::address::phid1.address ||
+            address == phy::address::phid2.address ||
+            address == phy::address::phir.address) {
+            return;
+        }
+        phy_[address] = value;
+    }
+    
+    void phy_interrupt() {
+        const std::uint16_t phie = phy_[phy::address::phie.address];
+        std::uint16_t &phir = phy_[phy::address::phir.address];
+        
+        phir |= phy_interrupt_bits::link;
+        if ((phie & phy_interrupt_bits::link) &&
+            (phie & phy_interrupt_bits::global_enable)) {
+            phir |= phy_interrupt_bits::global_flag;
+            reg(eth::address::eir) |= eir::linkif;
+        }
+    }
+    
+    /**
+     * Calls the interrupt handler when INT becomes asserted.
+     */
+    void update_interrupt() {
+        const bool asserted = interrupt();
+        if (asserted && !interrupt_pin_ && interrupt_handler_) {
+            interrupt_handler_();
+        }
+        interrupt_pin_ = asserted;
+    }
+    
+    /**
+     * Advances pending MII operations and transmissions by one
+     * transaction.
+     */
+    void tick() {
+        if (mii_operation_ != mii_operation::none && mii_countdown_ &&
+            !--mii_countdown_) {
+            complete_mii();
+        }
+        if (tx_pending_ && tx_countdown_ && !--tx_countdown_) {
+            complete_transmission();
+        }
+    }
+    
+    void start_transmission() {
+        if (reg(eth::address::econ1) & econ1::txrst) {
+            reg(eth::address::econ1) &= ~econ1::txrts;
+            return;
+        }
+        if (tx_stalled_) {
+            return;
+        }
+        
+        tx_pending_ = true;
+        tx_countdown_ = tx_latency_;
+        if (!tx_countdown_) {
+            complete_transmission();
+        }
+    }
+    
+    void complete_transmission() {
+        tx_pending_ = false;
+        
+        const std::uint16_t start = pair(eth::address::etxstl);
+        const std::uint16_t end = pair(eth::address::etxndl);
+        const std::uint8_t control = memory_[start];
+        std::uint8_t config = reg(mac::address::macon3);
+        
+        if (control & control_byte::poverride) {
+            config = (control & control_byte::ppaden ? macon3::pad_60 : 0) |
+                     (control & control_byte::pcrcen ? macon3::txcrcen : 0);
+        }
+        
+        std::size_t length = (end - start) & address_mask;
+        for (std::size_t i = 0; i < length; ++i) {
+            frame_[i] = memory_[(start + 1 + i) & address_mask];
+        }
+        
+        const std::size_t pad = pad_length(config, frame_.data(), length);
+        if (length < pad) {
+            std::fill(frame_.begin() + length, frame_.begin() + pad, 0);
+            length = pad;
+        }
+        if ((config & macon3::txcrcen) || (config & macon3::padcfg)) {
+            const std::uint32_t fcs = crc::compute(frame_.data(), length);
+            for (std::size_t i = 0; i < fcs_size; ++i) {
+                frame_[length++] = static_cast<std::uint8_t>(fcs >> (8 * i));
+            }
+        }
+        
+        const bool collision = late_collisions_ > 0;
+        std::uint32_t status = transmit_status(frame_.data(), length);
+        if (collision) {
+            --late_collisions_;
+            status = (status & ~tsv_done) | tsv_late_collision | 0x0001;
+        }
+        
+        const std::array<std::uint8_t, tsv_size> tsv{
+            static_cast<std::uint8_t>(length),
+            static_cast<std::uint8_t>(length >> 8),
+            static_cast<std::uint8_t>(status),
+            static_cast<std::uint8_t>(status >> 8),
+            static_cast<std::uint8_t>(length),
+            static_cast<std::uint8_t>(length >> 8),
+            0};
+        std::uint16_t pointer = end;
+        for (std::uint8_t b : tsv) {
+            pointer = (pointer + 1) & address_mask;
+            memory_[pointer] = b;
+        }
+        
+        reg(eth::address::econ1) &= ~econ1::txrts;
+        
+        if (collision) {
+            reg(eth::address::eir) |= eir::txif | eir::txerif;
+            reg(eth::address::estat) |= estat::latecol | estat::txabrt;
+            tx_stalled_ = true;
+            ++stats_.aborted_frames;
+            return;
+        }
+        
+        reg(eth::address::eir) |= eir::txif;
+        ++stats_.transmitted_frames;
+        
+        if (transmit_handler_) {
+            transmit_handler_(frame_.data(), length);
+        }
+    }
+    
+    void run_dma() {
+        const std::uint16_t start = pair(eth::address::edmastl);
+        const std::uint16_t end = pair(eth::address::edmandl);
+        const std::uint16_t rx_start = pair(eth::address::erxstl);
+        const std::uint16_t rx_end = pair(eth::address::erxndl);
+        const bool wrap = start >= rx_start && start <= rx_end;
+        const bool checksum = reg(eth::address::econ1) & econ1::csumen;
+        std::uint16_t destination = pair(eth::address::edmadstl);
+        
+        std::uint32_t sum = 0;
+        std::size_t count = 0;
+        for (std::uint16_t pointer = start; count < buffer_size; ++count) {
+            const std::uint8_t data = memory_[pointer];
+            if (checksum) {
+                sum += count & 1 ? data : data << 8;
+            } else {
+                memory_[destination] = data;
+                destination = (destination + 1) & address_mask;
+            }
+            
+            if (pointer == end) {
+                break;
+            }
+            pointer = wrap && pointer == rx_end ? rx_start
+                                                : (pointer + 1) & address_mask;
+        }
+        
+        if (checksum) {
+            while (sum >> 16) {
+                sum = (sum & 0xffff) + (sum >> 16);
+            }
+            pair(eth::address::edmacsl, static_cast<std::uint16_t>(~sum));
+        }
+        
+        reg(eth::address::econ1) &= ~econ1::dmast;
+        reg(eth::address::eir) |= eir::dmaif;
+    }
+    
+    static std::size_t pad_length(std::uint8_t config, const std::uint8_t *frame,
+                                  std::size_t length) {
+        switch (config & macon3::padcfg) {
+        case macon3::pad_60_vlan_64:
+            return length >= 14 && frame[12] == 0x81 && frame[13] == 0x00 ? 64 : 60;
+        case macon3::pad_64:
+            return 64;
+        case macon3::pad_60:
+            return 60;
+        default:
+            return 0;
+        }
+    }
+    
+    std::size_t rx_free_space() const {
+        const std::uint16_t start = pair(eth::address::erxstl);
+        const std::uint16_t end = pair(eth::address::erxndl);
+        const std::uint16_t write = pair(eth::address::erxwrptl);
+        const std::uint16_t read = pair(eth::address::erxrdptl);
+        
+        if (write > read) {
+            return (end - start) - (write - read);
+        }
+        if (write == read) {
+            return end - start;
+        }
+        return read - write - 1;
+    }
+    
+    std::uint16_t rx_increment(std::uint16_t pointer) const {
+        if (pointer == pair(eth::address::erxndl)) {
+            return pair(eth::address::erxstl);
+        }
+        return (pointer + 1) & address_mask;
+    }
+    
+    std::uint16_t rx_store(std::uint16_t pointer, std::uint8_t data) {
+        memory_[pointer] = data;
+        return rx_increment(pointer);
+    }
+    
+    filter::mac_address station_address() const {
+        return {reg(mac::address::maadr1), reg(mac::address::maadr2),
+                reg(mac::address::maadr3), reg(mac::address::maadr4),
+                reg(mac::address::maadr5), reg(mac::address::maadr6)};
+    }
+    
+    /**
+     * Applies the ERXFCON receive filters. Frames generated by the
+     * model never have CRC errors, so CRCEN has no effect.
+     */
+    bool accept(const std::uint8_t *frame, std::size_t size) const {
+        const std::uint8_t control = reg(eth::address::erxfcon);
+        if (!(control & ~(erxfcon::andor | erxfcon::crcen))) {
+            return true;
+        }
+        if (size < 6) {
+            return false;
+        }
+        
+        filter::mac_address destination{};
+        std::copy_n(frame, destination.size(), destination.begin());
+        
+        bool any = false;
+        bool all = true;
+        const auto check = [&](std::uint8_t enable, bool match) {
+            if (control & enable) {
+                any = any || match;
+                all = all && match;
+            }
+        };
+        
+        check(erxfcon::ucen, destination == station_address());
+        check(erxfcon::pmen, pattern_match(frame, size));
+        check(erxfcon::mpen, magic_packet(frame, size));
+        check(erxfcon::hten, hash_match(destination));
+        check(erxfcon::mcen, multicast(frame, size));
+        check(erxfcon::bcen, broadcast(frame, size));
+        
+        return control & erxfcon::andor ? all : any;
+    }
+    
+    bool hash_match(const filter::mac_address &destination) const {
+        std::array<std::uint8_t, filter::hash_table::size> table{};
+        for (std::uint8_t i = 0; i < table.size(); ++i) {
+            table[i] = reg(eth::address::eht0.offset(i));
+        }
+        return filter::hash_table(table).contains(destination);
+    }
+    
+    bool pattern_match(const std::uint8_t *frame, std::size_t size) const {
+        const std::size_t offset = pair(eth::address::epmol);
+        std::uint32_t sum = 0;
+        std::size_t selected = 0;
+        
+        for (std::uint8_t i = 0; i < 64; ++i) {
+            if (!(reg(eth::address::epmm0.offset(i / 8)) & (1 << (i % 8)))) {
+                continue;
+            }
+            if (offset + i >= size) {
+                return false;
+            }
+            const std::uint8_t data = frame[offset + i];
+            sum += selected++ & 1 ? data : data << 8;
+        }
+        while (sum >> 16) {
+            sum = (sum & 0xffff) + (sum >> 16);
+        }
+        return static_cast<std::uint16_t>(~sum) == pair(eth::address::epmcsl);
+    }
+    
+    bool magic_packet(const std::uint8_t *frame, std::size_t size) const {
+        const filter::mac_address station = station_address();
+        const std::size_t length = 6 + 16 * station.size();
+        
+        for (std::size_t start = 12; start + length <= size; ++start) {
+            bool match = std::all_of(frame + start, frame + start + 6,
+                                     [](std::uint8_t b) { return b == 0xff; });
+            for (std::size_t i = 0; match && i < 16; ++i) {
+                match = std::equal(station.begin(), station.end(),
+                                   frame + start + 6 + i * station.size());
+            }
+            if (match) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    static bool broadcast(const std::uint8_t *frame, std::size_t size) {
+        return size >= 6 && std::all_of(frame, frame + 6, [](std::uint8_t b) {
+            return b == 0xff;
+        });
+    }
+    
+    static bool multicast(const std::uint8_t *frame, std::size_t size) {
+        return size >= 6 && (frame[0] & 0x01) && !broadcast(frame, size);
+    }
+    
+    static std::uint32_t receive_status(const std::uint8_t *frame, std::size_t size) {
+        std::uint32_t status = 0x0080; // received ok
+        if (multicast(frame, size)) {
+            status |= 0x0100;
+        }
+        if (broadcast(frame, size)) {
+            status |= 0x0200;
+        }
+        return status;
+    }
+    
+    /**
+     * Bits of the second TSV word, starting at bit 16.
+     */
+    static constexpr std::uint32_t tsv_done = 0x0080;
+    static constexpr std::uint32_t tsv_late_collision = 0x2000;
+    
+    static std::uint32_t transmit_status(const std::uint8_t *frame, std::size_t size) {
+        std::uint32_t status = tsv_done;
+        if (multicast(frame, size)) {
+            status |= 0x0100;
+        }
+        if (broadcast(frame, size)) {
+            status |= 0x0200;
+        }
+        return status;
+    }
+    
+    std::array<std::uint8_t, 4 * 0x20> registers_{};
+    std::array<std::uint16_t, 0x20> phy_{};
+    std::array<std::uint8_t, buffer_size> memory_{};
+    std::array<std::uint8_t, buffer_size + fcs_size + 64> frame_{};
+    
+    std::size_t index_ = 0;
+    std::uint8_t command_ = 0;
+    
+    bool link_ = true;
+    bool interrupt_pin_ = false;
+    
+    mii_operation mii_operation_ = mii_operation::none;
+    unsigned mii_latency_ = 1;
+    unsigned mii_countdown_ = 0;
+    
+    bool tx_pending_ = false;
+    unsigned tx_latency_ = 0;
+    unsigned tx_countdown_ = 0;
+    bool tx_stalled_ = false;
+    unsigned late_collisions_ = 0;
+    
+    transmit_handler transmit_handler_;
+    interrupt_handler interrupt_handler_;
+    statistics stats_;
+};
+
+}
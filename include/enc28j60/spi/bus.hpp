@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace enc28j60::spi {
+
+/**
+ * Part of a transaction. If tx is nullptr zeros are shifted
+ * out, if rx is nullptr the received bytes are discarded.
+ */
+struct segment {
+    const std::uint8_t *tx;
+    std::uint8_t *rx;
+    std::size_t size;
+};
+
+/**
+ * SPI backend interface. Every call to transfer() is exactly one
+ * transaction: chip select is asserted before the first segment
+ * and released after the last one.
+ *
+ * Between begin_batch() and end_batch() a backend may defer
+ * transactions without rx data and submit them together with the
+ * next one that reads, or at the end of the batch. Batches nest.
+ *
+ * A backend that fails to submit transactions stays failed() until
+ * clear_error(). Data read while failed is undefined. Transactions
+ * longer than max_transfer() bytes fail.
+ */
+class bus {
+public:
+    virtual ~bus() = default;
+    
+    virtual void transfer(const segment *segments, std::size_t count) = 0;
+    
+    virtual void begin_batch() {}
+    
+    virtual void end_batch() {}
+    
+    virtual bool failed() const {
+        return false;
+    }
+    
+    virtual void clear_error() {}
+    
+    /**
+     * Largest transaction in bytes, all segments together.
+     */
+    virtual std::size_t max_transfer() const {
+        return std::numeric_limits<std::size_t>::max();
+    }
+    
+    void transfer(const std::uint8_t *tx, std::uint8_t *rx, std::size_t size) {
+        const segment single{tx, rx, size};
+        transfer(&single, 1);
+    }
+};
+
+/**
+ * Scope in which the transactions on a bus form one batch.
+ */
+class batch {
+public:
+    explicit batch(spi::bus &bus) : bus_(bus) {
+        bus_.begin_batch();
+    }
+    
+    batch(const batch &) = delete;
+    batch &operator=(const batch &) = delete;
+    
+    ~batch() {
+        bus_.end_batch();
+    }
+    
+private:
+    spi::bus &bus_;
+};
+
+}
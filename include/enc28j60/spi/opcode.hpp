@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+namespace enc28j60::spi {
+
+enum class opcode : std::uint8_t {
+    read_control_register = 0x00,
+    read_buffer_memory = 0x20,
+    write_control_register = 0x40,
+    write_buffer_memory = 0x60,
+    bit_field_set = 0x80,
+    bit_field_clear = 0xa0,
+    system_reset = 0xe0
+};
+
+struct argument {
+    enum : std::uint8_t {
+        /**
+         * Argument of read/write buffer memory commands.
+         */
+        buffer_memory = 0x1a,
+        
+        /**
+         * Argument of the system reset command.
+         */
+        system_reset = 0x1f,
+        
+        mask = 0x1f
+    };
+};
+
+constexpr std::uint8_t encode(opcode op, std::uint8_t argument) {
+    return static_cast<std::uint8_t>(op) | (argument & argument::mask);
+}
+
+constexpr opcode decode_opcode(std::uint8_t command) {
+    return opcode{static_cast<std::uint8_t>(command & ~argument::mask)};
+}
+
+constexpr std::uint8_t decode_argument(std::uint8_t command) {
+    return command & argument::mask;
+}
+
+}
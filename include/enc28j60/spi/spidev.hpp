@@ -0,0 +1,258 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <linux/spi/spidev.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <enc28j60/spi/bus.hpp>
+
+namespace enc28j60::spi {
+
+/**
+ * The one system call spidev_bus needs, so it can be replaced by
+ * a recording fake.
+ */
+class spidev_io {
+public:
+    virtual ~spidev_io() = default;
+    
+    /**
+     * Submits the transfers as one SPI_IOC_MESSAGE, returns false
+     * on failure.
+     */
+    virtual bool message(const spi_ioc_transfer *transfers,
+                         std::size_t count) = 0;
+};
+
+/**
+ * A /dev/spidevX.Y device configured for the ENC28J60: mode 0 and
+ * 8 bits per word.
+ */
+class spidev_file : public spidev_io {
+public:
+    spidev_file(const char *path, std::uint32_t speed_hz) {
+        fd_ = ::open(path, O_RDWR | O_CLOEXEC);
+        if (fd_ < 0) {
+            return;
+        }
+        
+        const std::uint8_t mode = SPI_MODE_0;
+        const std::uint8_t bits = 8;
+        if (::ioctl(fd_, SPI_IOC_WR_MODE, &mode) < 0 ||
+            ::ioctl(fd_, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0 ||
+            ::ioctl(fd_, SPI_IOC_WR_MAX_SPEED_HZ, &speed_hz) < 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+    
+    spidev_file(const spidev_file &) = delete;
+    spidev_file &operator=(const spidev_file &) = delete;
+    
+    ~spidev_file() override {
+        if (valid()) {
+            ::close(fd_);
+        }
+    }
+    
+    bool valid() const {
+        return fd_ >= 0;
+    }
+    
+    bool message(const spi_ioc_transfer *transfers,
+                 std::size_t count) override {
+        return ::ioctl(fd_, SPI_IOC_MESSAGE(count), transfers) >= 0;
+    }
+    
+private:
+    int fd_ = -1;
+};
+
+/**
+ * SPI bus on top of the Linux spidev driver.
+ *
+ * Every segment becomes one spi_ioc_transfer, cs_change on the
+ * last segment of a transaction releases chip select before the
+ * next one. Inside a batch, short transactions that don't read are
+ * copied and queued, so a sequence like bank switch, WCR, WCR,
+ * BFS ECON1.TXRTS costs a single system call.
+ */
+class spidev_bus : public bus {
+public:
+    struct statistics {
+        /**
+         * SPI_IOC_MESSAGE system calls.
+         */
+        std::uint64_t messages = 0;
+        std::uint64_t transactions = 0;
+        
+        /**
+         * Transactions queued instead of submitted immediately.
+         */
+        std::uint64_t deferred = 0;
+        std::uint64_t errors = 0;
+    };
+    
+    /**
+     * Largest transaction that gets copied and deferred.
+     */
+    static constexpr std::size_t defer_limit = 16;
+    
+    /**
+     * Limit of the ioctl size field.
+     */
+    static constexpr std::size_t max_transfers =
+        ((1u << _IOC_SIZEBITS) - 1) / sizeof(spi_ioc_transfer);
+    
+    /**
+     * `message_size` has to match the bufsiz parameter of the
+     * spidev module, the limit for the bytes of all transfers in
+     * one message. A longer transaction is refused and fails the
+     * bus without reaching the driver.
+     */
+    spidev_bus(spidev_io &io, std::uint32_t speed_hz,
+               std::size_t message_size = 4096)
+        : io_(io), speed_hz_(speed_hz), message_size_(message_size) {
+        transfers_.reserve(max_transfers);
+        arena_.reserve(message_size);
+    }
+    
+    ~spidev_bus() override {
+        flush();
+    }
+    
+    void transfer(const segment *segments, std::size_t count) override {
+        std::size_t size = 0;
+        bool reads = false;
+        for (std::size_t i = 0; i < count; ++i) {
+            size += segments[i].size;
+            reads = reads || segments[i].rx;
+        }
+        
+        if (size > message_size_ || count > max_transfers) {
+            ++stats_.errors;
+            failed_ = true;
+            return;
+        }
+        
+        if (transfers_.size() + count > max_transfers ||
+            queued_bytes_ + size > message_size_) {
+            flush();
+        }
+        
+        ++stats_.transactions;
+        const bool defer = depth_ && !reads && size <= defer_limit;
+        
+        for (std::size_t i = 0; i < count; ++i) {
+            const segment &s = segments[i];
+            if (!s.size) {
+                continue;
+            }
+            
+            spi_ioc_transfer t{};
+            if (defer) {
+                const std::size_t offset = arena_.size();
+                arena_.resize(offset + s.size);
+                if (s.tx) {
+                    std::memcpy(&arena_[offset], s.tx, s.size);
+                }
+                t.tx_buf = reinterpret_cast<std::uintptr_t>(&arena_[offset]);
+            } else {
+                t.tx_buf = reinterpret_cast<std::uintptr_t>(s.tx);
+                t.rx_buf = reinterpret_cast<std::uintptr_t>(s.rx);
+            }
+            t.len = static_cast<std::uint32_t>(s.size);
+            t.speed_hz = speed_hz_;
+            t.bits_per_word = 8;
+            transfers_.push_back(t);
+            queued_bytes_ += s.size;
+        }
+        
+        if (!transfers_.empty()) {
+            transfers_.back().cs_change = 1;
+        }
+        
+        if (defer) {
+            ++stats_.deferred;
+        } else {
+            flush();
+        }
+    }
+    
+    void begin_batch() override {
+        ++depth_;
+    }
+    
+    void end_batch() override {
+        if (depth_ && !--depth_) {
+            flush();
+        }
+    }
+    
+    /**
+     * Submits all queued transactions.
+     */
+    void flush() {
+        if (transfers_.empty()) {
+            return;
+        }
+        
+        // cs_change on the last transfer would keep chip select
+        // asserted after the message
+        transfers_.back().cs_change = 0;
+        
+        ++stats_.messages;
+        if (!io_.message(transfers_.data(), transfers_.size())) {
+            ++stats_.errors;
+            failed_ = true;
+        }
+        
+        transfers_.clear();
+        arena_.clear();
+        queued_bytes_ = 0;
+    }
+    
+    /**
+     * Set when a SPI_IOC_MESSAGE call failed. Everything queued with
+     * it may or may not have reached the device.
+     */
+    bool failed() const override {
+        return failed_;
+    }
+    
+    void clear_error() override {
+        failed_ = false;
+    }
+    
+    std::size_t max_transfer() const override {
+        return message_size_;
+    }
+    
+    const statistics &stats() const {
+        return stats_;
+    }
+    
+private:
+    spidev_io &io_;
+    std::uint32_t speed_hz_;
+    std::size_t message_size_;
+    
+    std::vector<spi_ioc_transfer> transfers_;
+    
+    /**
+     * tx data of deferred transactions. Never exceeds the capacity
+     * reserved up front, so queued pointers stay valid.
+     */
+    std::vector<std::uint8_t> arena_;
+    std::size_t queued_bytes_ = 0;
+    
+    unsigned depth_ = 0;
+    bool failed_ = false;
+    statistics stats_;
+};
+
+}
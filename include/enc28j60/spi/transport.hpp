@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <enc28j60/detail/register_address.hpp>
+#include <enc28j60/spi/bus.hpp>
+#include <enc28j60/spi/opcode.hpp>
+
+namespace enc28j60::spi {
+
+/**
+ * Encodes the ENC28J60 SPI instruction set. Every operation is
+ * a single transaction on the bus.
+ *
+ * The transport does not track the selected bank: the caller
+ * is responsible for ECON1.BSEL matching the bank of banked
+ * registers.
+ */
+class transport {
+public:
+    explicit transport(spi::bus &bus) : bus_(bus) {}
+    
+    spi::bus &bus() const {
+        return bus_;
+    }
+    
+    std::uint8_t read(register_address reg) {
+        assert(reg.kind != register_kind::phy);
+        
+        const std::size_t size = reg.dummy_byte() ? 3 : 2;
+        const std::array<std::uint8_t, 3> tx{
+            encode(opcode::read_control_register, reg.address), 0, 0};
+        std::array<std::uint8_t, 3> rx{};
+        
+        bus_.transfer(tx.data(), rx.data(), size);
+        return rx[size - 1];
+    }
+    
+    void write(register_address reg, std::uint8_t value) {
+        assert(reg.kind != register_kind::phy);
+        
+        command(opcode::write_control_register, reg.address, value);
+    }
+    
+    /**
+     * Sets every bit of `bits` in an ETH register.
+     */
+    void set_bits(register_address reg, std::uint8_t bits) {
+        assert(reg.bit_field_operations());
+        
+        command(opcode::bit_field_set, reg.address, bits);
+    }
+    
+    /**
+     * Clears every bit of `bits` in an ETH register.
+     */
+    void clear_bits(register_address reg, std::uint8_t bits) {
+        assert(reg.bit_field_operations());
+        
+        command(opcode::bit_field_clear, reg.address, bits);
+    }
+    
+    /**
+     * Reads from the buffer memory at ERDPT. `discard` more bytes
+     * are clocked out in the same transaction and dropped, which
+     * moves ERDPT past them.
+     */
+    void read_buffer(std::uint8_t *data, std::size_t size,
+                     std::size_t discard = 0) {
+        const std::uint8_t op =
+            encode(opcode::read_buffer_memory, argument::buffer_memory);
+        const std::array<segment, 3> segments{
+            segment{&op, nullptr, 1}, segment{nullptr, data, size},
+            segment{nullptr, nullptr, discard}};
+        
+        bus_.transfer(segments.data(), discard ? 3 : 2);
+    }
+    
+    /**
+     * Writes to the buffer memory at EWRPT.
+     */
+    void write_buffer(const std::uint8_t *data, std::size_t size) {
+        const std::uint8_t op =
+            encode(opcode::write_buffer_memory, argument::buffer_memory);
+        const std::array<segment, 2> segments{
+            segment{&op, nullptr, 1}, segment{data, nullptr, size}};
+        
+        bus_.transfer(segments.data(), segments.size());
+    }
+    
+    void system_reset() {
+        const std::uint8_t op =
+            encode(opcode::system_reset, argument::system_reset);
+        
+        bus_.transfer(&op, nullptr, 1);
+    }
+    
+    template<typename Register>
+    Register read() {
+        static_assert(sizeof(typename Register::native_type) == 1,
+                      "Only 8 bit registers are directly accessible.");
+        
+        return Register(read(Register::address));
+    }
+    
+    template<typename Register>
+    void write(const Register &reg) {
+        static_assert(sizeof(typename Register::native_type) == 1,
+                      "Only 8 bit registers are directly accessible.");
+        
+        write(Register::address, reg.data());
+    }
+    
+private:
+    void command(opcode op, std::uint8_t address, std::uint8_t data) {
+        const std::array<std::uint8_t, 2> tx{encode(op, address), data};
+        
+        bus_.transfer(tx.data(), nullptr, tx.size());
+    }
+    
+    spi::bus &bus_;
+};
+
+}
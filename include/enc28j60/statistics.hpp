@@ -0,0 +1,307 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace enc28j60 {
+
+/**
+ * Counters kept by the driver layer for one device.
+ *
+ * Every value has a single writer, the thread driving the device,
+ * so updates are a relaxed load and store without a locked
+ * instruction. take() may be called from any other thread at any
+ * time; it sees each value atomically, but not all values at the
+ * same instant.
+ */
+class statistics {
+public:
+    using clock = std::chrono::steady_clock;
+    
+    class counter {
+    public:
+        void add(std::uint64_t n = 1) {
+            value_.store(value_.load(std::memory_order_relaxed) + n,
+                         std::memory_order_relaxed);
+        }
+        
+        std::uint64_t load() const {
+            return value_.load(std::memory_order_relaxed);
+        }
+        
+    private:
+        std::atomic<std::uint64_t> value_{0};
+    };
+    
+    /**
+     * Highest value observed.
+     */
+    class high_water {
+    public:
+        void update(std::uint64_t value) {
+            if (value > value_.load(std::memory_order_relaxed)) {
+                value_.store(value, std::memory_order_relaxed);
+            }
+        }
+        
+        std::uint64_t load() const {
+            return value_.load(std::memory_order_relaxed);
+        }
+        
+    private:
+        std::atomic<std::uint64_t> value_{0};
+    };
+    
+    /**
+     * Current value of a setting or state.
+     */
+    class gauge {
+    public:
+        void set(std::uint64_t value) {
+            value_.store(value, std::memory_order_relaxed);
+        }
+        
+        std::uint64_t load() const {
+            return value_.load(std::memory_order_relaxed);
+        }
+        
+    private:
+        std::atomic<std::uint64_t> value_{0};
+    };
+    
+    /**
+     * Latency histogram with power of two buckets: bucket n counts
+     * durations of [2^n, 2^(n+1)) nanoseconds, the last one
+     * everything longer.
+     */
+    class histogram {
+    public:
+        static constexpr std::size_t buckets = 32;
+        
+        using values = std::array<std::uint64_t, buckets>;
+        
+        void record(std::chrono::nanoseconds duration) {
+            const auto ns = static_cast<std::uint64_t>(duration.count()) | 1;
+            const std::size_t bucket = 63 - __builtin_clzll(ns);
+            buckets_[bucket < buckets ? bucket : buckets - 1].add();
+        }
+        
+        values load() const {
+            values v{};
+            for (std::size_t i = 0; i < buckets; ++i) {
+                v[i] = buckets_[i].load();
+            }
+            return v;
+        }
+        
+    private:
+        std::array<counter, buckets> buckets_;
+    };
+    
+    /**
+     * Records the time from construction to destruction.
+     */
+    class timer {
+    public:
+        explicit timer(histogram &h) : histogram_(h), start_(clock::now()) {}
+        
+        timer(const timer &) = delete;
+        timer &operator=(const timer &) = delete;
+        
+        ~timer() {
+            histogram_.record(clock::now() - start_);
+        }
+        
+    private:
+        histogram &histogram_;
+        clock::time_point start_;
+    };
+    
+    struct snapshot {
+        std::uint64_t spi_transactions;
+        std::uint64_t spi_bytes;
+        std::uint64_t bank_switches;
+        std::uint64_t bank_switches_elided;
+        
+        std::uint64_t rx_frames;
+        std::uint64_t rx_bytes;
+        std::uint64_t rx_crc_errors;
+        std::uint64_t rx_length_errors;
+        std::uint64_t rx_truncated;
+        std::uint64_t rx_ring_errors;
+        std::uint64_t rx_overflows;
+        std::uint64_t rx_pending_high_water;
+        std::uint64_t rx_polling;
+        std::uint64_t rx_polling_threshold;
+        std::uint64_t rx_poll_budget;
+        std::uint64_t rx_polling_entered;
+        std::uint64_t rx_polling_left;
+        std::uint64_t rx_poll_passes;
+        std::uint64_t rx_budget_exhausted;
+        
+        std::uint64_t tx_frames;
+        std::uint64_t tx_bytes;
+        std::uint64_t tx_errors;
+        std::uint64_t tx_late_collisions;
+        std::uint64_t tx_excessive_collisions;
+        std::uint64_t tx_excessive_deferrals;
+        std::uint64_t tx_underruns;
+        std::uint64_t tx_retries;
+        std::uint64_t tx_aborts;
+        
+        std::uint64_t interrupts;
+        std::uint64_t interrupts_spurious;
+        
+        std::uint64_t flow_pauses;
+        std::uint64_t flow_releases;
+        
+        histogram::values rx_latency;
+        histogram::values tx_latency;
+        histogram::values phy_latency;
+        histogram::values interrupt_latency;
+    };
+    
+    counter spi_transactions;
+    counter spi_bytes;
+    
+    /**
+     * Bank switches put on the bus, and accesses to banked
+     * registers that found their bank already selected.
+     */
+    counter bank_switches;
+    counter bank_switches_elided;
+    
+    counter rx_frames;
+    counter rx_bytes;
+    
+    /**
+     * Received frames with the RSV reporting a CRC error, or a
+     * length check error or out of range length.
+     */
+    counter rx_crc_errors;
+    counter rx_length_errors;
+    
+    /**
+     * Frames larger than the buffer they were read into.
+     */
+    counter rx_truncated;
+    
+    /**
+     * Corrupted ring headers.
+     */
+    counter rx_ring_errors;
+    
+    /**
+     * EIR.RXERIF occurrences seen by the interrupt dispatcher, each
+     * stands for one or more frames lost to a full ring or EPKTCNT
+     * overflow.
+     */
+    counter rx_overflows;
+    
+    /**
+     * Largest EPKTCNT seen.
+     */
+    high_water rx_pending_high_water;
+    
+    /**
+     * Receive scheduler: 1 while it polls with PKTIE masked, its
+     * current thresholds, the mode switches and the polling passes,
+     * counting those that ended with frames left over.
+     */
+    gauge rx_polling;
+    gauge rx_polling_threshold;
+    gauge rx_poll_budget;
+    counter rx_polling_entered;
+    counter rx_polling_left;
+    counter rx_poll_passes;
+    counter rx_budget_exhausted;
+    
+    counter tx_frames;
+    counter tx_bytes;
+    
+    /**
+     * EIR.TXERIF occurrences seen by the interrupt dispatcher.
+     */
+    counter tx_errors;
+    
+    /**
+     * Transmission attempts failed according to the TSV, and
+     * frames given up on after the late collision retry budget or
+     * another abort.
+     */
+    counter tx_late_collisions;
+    counter tx_excessive_collisions;
+    counter tx_excessive_deferrals;
+    counter tx_underruns;
+    counter tx_retries;
+    counter tx_aborts;
+    
+    /**
+     * Interrupt service passes, and those that found no flag set
+     * in EIR.
+     */
+    counter interrupts;
+    counter interrupts_spurious;
+    
+    /**
+     * Link partner throttled by the flow control engine, with
+     * PAUSE frames or back pressure, and released again.
+     */
+    counter flow_pauses;
+    counter flow_releases;
+    
+    /**
+     * Duration of rx::ring::receive(), tx::queue::send(), a PHY
+     * access from start to completion and one interrupt service
+     * pass.
+     */
+    histogram rx_latency;
+    histogram tx_latency;
+    histogram phy_latency;
+    histogram interrupt_latency;
+    
+    snapshot take() const {
+        return snapshot{
+            spi_transactions.load(),
+            spi_bytes.load(),
+            bank_switches.load(),
+            bank_switches_elided.load(),
+            rx_frames.load(),
+            rx_bytes.load(),
+            rx_crc_errors.load(),
+            rx_length_errors.load(),
+            rx_truncated.load(),
+            rx_ring_errors.load(),
+            rx_overflows.load(),
+            rx_pending_high_water.load(),
+            rx_polling.load(),
+            rx_polling_threshold.load(),
+            rx_poll_budget.load(),
+            rx_polling_entered.load(),
+            rx_polling_left.load(),
+            rx_poll_passes.load(),
+            rx_budget_exhausted.load(),
+            tx_frames.load(),
+            tx_bytes.load(),
+            tx_errors.load(),
+            tx_late_collisions.load(),
+            tx_excessive_collisions.load(),
+            tx_excessive_deferrals.load(),
+            tx_underruns.load(),
+            tx_retries.load(),
+            tx_aborts.load(),
+            interrupts.load(),
+            interrupts_spurious.load(),
+            flow_pauses.load(),
+            flow_releases.load(),
+            rx_latency.load(),
+            tx_latency.load(),
+            phy_latency.load(),
+            interrupt_latency.load()};
+    }
+};
+
+}
@@ -0,0 +1,319 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <enc28j60/device.hpp>
+#include <enc28j60/dma/engine.hpp>
+#include <enc28j60/eth/address.hpp>
+#include <enc28j60/eth/register.hpp>
+#include <enc28j60/spi/bus.hpp>
+#include <enc28j60/statistics.hpp>
+#include <enc28j60/tx/status_vector.hpp>
+
+namespace enc28j60::tx {
+
+/**
+ * Result of a frame leaving the queue.
+ */
+struct outcome {
+    /**
+     * TSV of the last transmission attempt.
+     */
+    status_vector status;
+    
+    /**
+     * Transmission attempts, more than one after late collision
+     * retries.
+     */
+    unsigned attempts;
+    
+    bool ok() const {
+        return status.done();
+    }
+};
+
+/**
+ * Transmit queue splitting a region of the buffer memory into
+ * `Slots` equally sized transmit slots.
+ *
+ * While one slot is on the wire the following slots can be loaded,
+ * so the next transmission starts as soon as the current one
+ * completes instead of after the next SPI load.
+ *
+ * Frames aborted by a late collision, which happens on half duplex
+ * links, are retried up to a configurable number of times. Every
+ * retry is preceded by the transmit logic reset the silicon errata
+ * require after an abort, otherwise the next transmission can
+ * stall forever.
+ */
+template<std::size_t Slots = 2>
+class queue {
+    static_assert(Slots >= 2, "At least two slots are required.");
+    
+public:
+    /**
+     * Per packet control byte in front of every frame and status
+     * vector written behind it.
+     */
+    static constexpr std::uint16_t control_size = 1;
+    static constexpr std::uint16_t status_size = 7;
+    
+    /**
+     * Slots start at `start` and occupy `slot_size` bytes each,
+     * including control byte and status vector. A frame hit by a
+     * late collision is transmitted up to `retries` more times.
+     */
+    queue(device &dev, std::uint16_t start, std::uint16_t slot_size,
+          unsigned retries = 3)
+        : device_(dev), start_(start), slot_size_(slot_size),
+          retries_(retries) {}
+        
+    /**
+     * Writes the control bytes of all slots. A zero control byte
+     * makes the MAC use the MACON3 settings for every frame.
+     */
+    void init() {
+        const std::uint8_t control = 0;
+        for (std::size_t i = 0; i < Slots; ++i) {
+            device_.write_pair(eth::address::ewrptl, slot_start(i));
+            device_.write_buffer(&control, control_size);
+        }
+        head_ = 0;
+        loaded_ = 0;
+        active_ = false;
+    }
+    
+    /**
+     * Largest frame a slot can take, without FCS if the MAC
+     * appends it.
+     */
+    std::uint16_t max_frame_size() const {
+        return slot_size_ - control_size - status_size;
+    }
+    
+    std::size_t free_slots() const {
+        return Slots - loaded_;
+    }
+    
+    bool idle() const {
+        return loaded_ == 0;
+    }
+    
+    /**
+     * Loads a frame into the next free slot and starts it if the
+     * transmitter is idle. Returns false if all slots are in use
+     * or the frame does not fit.
+     */
+    bool send(const std::uint8_t *frame, std::size_t size) {
+        if (!free_slots() || size == 0 || size > max_frame_size()) {
+            return false;
+        }
+        
+        const statistics::timer timer(device_.stats().tx_latency);
+        const spi::batch batch(device_.bus());
+        const std::size_t index = (head_ + loaded_) % Slots;
+        device_.write_pair(eth::address::ewrptl,
+                           slot_start(index) + control_size);
+        device_.write_buffer(frame, size);
+        sizes_[index] = static_cast<std::uint16_t>(size);
+        ++loaded_;
+        
+        if (!active_) {
+            start(index);
+        }
+        return true;
+    }
+    
+    /**
+     * Loads the frame in [start, end] of the buffer memory into the
+     * next free slot with the DMA engine, without moving it over SPI.
+     * Ranges starting inside the receive ring may wrap. Afterwards
+     * `patch_size` bytes of `patch` replace the frame contents at
+     * `patch_offset`, for example to rewrite the MAC addresses.
+     *
+     * Returns false if all slots are in use, the frame does not fit
+     * or the copy did not finish. In the last case the slot is left
+     * free, but the DMA engine may still write to it until
+     * dma.poll() returns true.
+     */
+    bool forward(dma::engine &dma, std::uint16_t start, std::uint16_t end,
+                 std::uint16_t size, std::uint16_t patch_offset = 0,
+                 const std::uint8_t *patch = nullptr,
+                 std::uint16_t patch_size = 0) {
+        if (!free_slots() || size == 0 || size > max_frame_size() ||
+            patch_offset + patch_size > size) {
+            return false;
+        }
+        
+        const spi::batch batch(device_.bus());
+        const std::size_t index = (head_ + loaded_) % Slots;
+        const std::uint16_t frame = slot_start(index) + control_size;
+        if (!dma.copy(start, end, frame)) {
+            return false;
+        }
+        
+        if (patch_size) {
+            device_.write_pair(eth::address::ewrptl, frame + patch_offset);
+            device_.write_buffer(patch, patch_size);
+        }
+        
+        sizes_[index] = size;
+        ++loaded_;
+        
+        if (!active_) {
+            this->start(index);
+        }
+        return true;
+    }
+    
+    /**
+     * Finishes the transmission on the wire, to be called once per
+     * finished transmission, not once per flag: an abort sets
+     * EIR.TXIF and EIR.TXERIF together. `acknowledge` clears both
+     * and can be false if irq::dispatcher already did.
+     *
+     * Reads the TSV and either restarts the frame after a late
+     * collision or releases its slot and starts the next loaded
+     * one. Returns the outcome of a released frame, std::nullopt
+     * if nothing was active or the frame is being retried.
+     */
+    std::optional<outcome> complete(bool acknowledge = true) {
+        if (!active_) {
+            return std::nullopt;
+        }
+        
+        const spi::batch batch(device_.bus());
+        if (acknowledge) {
+            device_.clear_bits(eth::address::eir, txif | txerif);
+        }
+        
+        const status_vector status = read_status(head_);
+        const outcome result{status, ++attempts_};
+        count(status);
+        
+        if (!status.done()) {
+            reset_transmit_logic();
+            if (status.late_collision() && attempts_ <= retries_) {
+                device_.stats().tx_retries.add();
+                start(head_);
+                return std::nullopt;
+            }
+            device_.stats().tx_aborts.add();
+        }
+        
+        active_ = false;
+        attempts_ = 0;
+        head_ = (head_ + 1) % Slots;
+        --loaded_;
+        
+        if (loaded_) {
+            start(head_);
+        }
+        return result;
+    }
+    
+    /**
+     * Completes the active transmission if ECON1.TXRTS has been
+     * cleared by the device, for operation without interrupts.
+     */
+    std::optional<outcome> poll() {
+        if (active_ &&
+            !eth::control_register_1(
+                device_.read(eth::address::econ1)).transmit_request()) {
+            return complete();
+        }
+        return std::nullopt;
+    }
+    
+    /**
+     * Start address of the slot currently on the wire.
+     */
+    std::uint16_t active_slot() const {
+        return slot_start(head_);
+    }
+    
+    std::uint16_t slot_start(std::size_t index) const {
+        return static_cast<std::uint16_t>(start_ + index * slot_size_);
+    }
+    
+private:
+    static constexpr std::uint8_t txif =
+        eth::interrupt_request().transmit(true).data();
+    static constexpr std::uint8_t txerif =
+        eth::interrupt_request().transmit_error(true).data();
+    
+    /**
+     * The TSV follows the frame, at ETXND + 1.
+     */
+    status_vector read_status(std::size_t index) {
+        std::array<std::uint8_t, status_vector::size> data;
+        device_.read_pointer(slot_start(index) + control_size + sizes_[index]);
+        device_.read_buffer(data.data(), data.size());
+        
+        std::uint64_t value = 0;
+        for (std::size_t i = data.size(); i-- > 0;) {
+            value = value << 8 | data[i];
+        }
+        return status_vector(value);
+    }
+    
+    void count(const status_vector &status) {
+        statistics &stats = device_.stats();
+        if (status.done()) {
+            stats.tx_frames.add();
+            stats.tx_bytes.add(status.byte_count());
+        }
+        if (status.late_collision()) {
+            stats.tx_late_collisions.add();
+        }
+        if (status.excessive_collisions()) {
+            stats.tx_excessive_collisions.add();
+        }
+        if (status.excessive_deferral()) {
+            stats.tx_excessive_deferrals.add();
+        }
+        if (status.underrun()) {
+            stats.tx_underruns.add();
+        }
+    }
+    
+    /**
+     * Pulses ECON1.TXRST, then clears the error flags the reset
+     * may raise again.
+     */
+    void reset_transmit_logic() {
+        const std::uint8_t reset =
+            eth::control_register_1(0).transmit_logic_reset(true).data();
+        device_.set_bits(eth::address::econ1, reset);
+        device_.clear_bits(eth::address::econ1, reset);
+        device_.clear_bits(eth::address::eir, txerif);
+        device_.clear_bits(eth::address::estat,
+                           eth::status().late_collision(true)
+                               .transmit_abort(true).data());
+    }
+    
+    void start(std::size_t index) {
+        const std::uint16_t begin = slot_start(index);
+        device_.write_pair(eth::address::etxstl, begin);
+        device_.write_pair(eth::address::etxndl, begin + sizes_[index]);
+        device_.set_bits(eth::address::econ1,
+                         eth::control_register_1(0).transmit_request(true).data());
+        active_ = true;
+    }
+    
+    device &device_;
+    std::uint16_t start_;
+    std::uint16_t slot_size_;
+    
+    std::array<std::uint16_t, Slots> sizes_{};
+    std::size_t head_ = 0;
+    std::size_t loaded_ = 0;
+    bool active_ = false;
+    
+    unsigned retries_;
+    unsigned attempts_ = 0;
+};
+
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <enc28j60/detail/base_register.hpp>
+
+namespace enc28j60::tx {
+
+/**
+ * Transmit status vector written by the device right behind every
+ * transmitted frame, at ETXND + 1.
+ */
+class status_vector : public base_register<std::uint64_t> {
+    using base = base_register<std::uint64_t>;
+    
+    struct fields {
+        using byte_count = base::field<0x000000000000ffff, std::uint16_t>;
+        using collision_count = base::field<0x00000000000f0000, std::uint8_t>;
+        using crc_error = base::field<0x0000000000100000>;
+        using length_check_error = base::field<0x0000000000200000>;
+        using length_out_of_range = base::field<0x0000000000400000>;
+        using done = base::field<0x0000000000800000>;
+        using multicast = base::field<0x0000000001000000>;
+        using broadcast = base::field<0x0000000002000000>;
+        using deferred = base::field<0x0000000004000000>;
+        using excessive_deferral = base::field<0x0000000008000000>;
+        using excessive_collisions = base::field<0x0000000010000000>;
+        using late_collision = base::field<0x0000000020000000>;
+        using giant = base::field<0x0000000040000000>;
+        using underrun = base::field<0x0000000080000000>;
+        using wire_byte_count = base::field<0x0000ffff00000000, std::uint16_t>;
+        using control_frame = base::field<0x0001000000000000>;
+        using pause_control_frame = base::field<0x0002000000000000>;
+        using back_pressure = base::field<0x0004000000000000>;
+        using vlan = base::field<0x0008000000000000>;
+    };
+    
+    static_assert(disjoint<fields::byte_count, fields::collision_count,
+                           fields::crc_error, fields::length_check_error,
+                           fields::length_out_of_range, fields::done,
+                           fields::multicast, fields::broadcast,
+                           fields::deferred, fields::excessive_deferral,
+                           fields::excessive_collisions,
+                           fields::late_collision, fields::giant,
+                           fields::underrun, fields::wire_byte_count,
+                           fields::control_frame,
+                           fields::pause_control_frame,
+                           fields::back_pressure, fields::vlan>());
+    
+public:
+    static constexpr std::uint8_t size = 7;
+    
+    constexpr status_vector() = default;
+    
+    constexpr status_vector(std::uint64_t data) : base(data) {}
+    
+    /**
+     * Bytes of the frame, not counting collided attempts.
+     */
+    constexpr std::uint16_t byte_count() const {
+        return base::get<fields::byte_count>();
+    }
+    
+    /**
+     * Collisions of the frame during its transmission attempts.
+     */
+    constexpr std::uint8_t collision_count() const {
+        return base::get<fields::collision_count>();
+    }
+    
+    constexpr bool crc_error() const {
+        return base::get<fields::crc_error>();
+    }
+    
+    constexpr bool length_check_error() const {
+        return base::get<fields::length_check_error>();
+    }
+    
+    constexpr bool length_out_of_range() const {
+        return base::get<fields::length_out_of_range>();
+    }
+    
+    /**
+     * The frame was transmitted successfully.
+     */
+    constexpr bool done() const {
+        return base::get<fields::done>();
+    }
+    
+    constexpr bool multicast() const {
+        return base::get<fields::multicast>();
+    }
+    
+    constexpr bool broadcast() const {
+        return base::get<fields::broadcast>();
+    }
+    
+    /**
+     * The medium was busy at the first attempt.
+     */
+    constexpr bool deferred() const {
+        return base::get<fields::deferred>();
+    }
+    
+    /**
+     * Aborted after deferring for more than 24287 bit times.
+     */
+    constexpr bool excessive_deferral() const {
+        return base::get<fields::excessive_deferral>();
+    }
+    
+    /**
+     * Aborted after more than MACLCON1 retransmissions.
+     */
+    constexpr bool excessive_collisions() const {
+        return base::get<fields::excessive_collisions>();
+    }
+    
+    /**
+     * Aborted by a collision after MACLCON2 bytes.
+     */
+    constexpr bool late_collision() const {
+        return base::get<fields::late_collision>();
+    }
+    
+    constexpr bool giant() const {
+        return base::get<fields::giant>();
+    }
+    
+    constexpr bool underrun() const {
+        return base::get<fields::underrun>();
+    }
+    
+    /**
+     * Bytes put on the wire, including collided attempts.
+     */
+    constexpr std::uint16_t wire_byte_count() const {
+        return base::get<fields::wire_byte_count>();
+    }
+    
+    constexpr bool control_frame() const {
+        return base::get<fields::control_frame>();
+    }
+    
+    constexpr bool pause_control_frame() const {
+        return base::get<fields::pause_control_frame>();
+    }
+    
+    constexpr bool back_pressure() const {
+        return base::get<fields::back_pressure>();
+    }
+    
+    constexpr bool vlan() const {
+        return base::get<fields::vlan>();
+    }
+};
+
+}
@@ -0,0 +1,208 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <enc28j60/device.hpp>
+#include <enc28j60/eth/register.hpp>
+#include <enc28j60/init/layout.hpp>
+#include <enc28j60/init/script.hpp>
+#include <enc28j60/mac/register.hpp>
+#include <enc28j60/pcap/file.hpp>
+#include <enc28j60/pcap/replay.hpp>
+#include <enc28j60/rx/ring.hpp>
+#include <enc28j60/sim/chip.hpp>
+#include <enc28j60/tx/queue.hpp>
+
+using namespace enc28j60;
+
+namespace {
+
+/**
+ * Receive ring and two transmit slots large enough for maximum
+ * sized frames.
+ */
+constexpr init::layout plan = init::plan<0x1400, 2>();
+
+/**
+ * Reception is enabled after the ring is set up.
+ */
+constexpr init::configuration layout = [] {
+    init::configuration config = plan.apply(init::configuration());
+    config.enable_receive = false;
+    return config;
+}();
+
+constexpr auto image = init::script<init::script_size(layout)>(layout);
+
+void usage(const char *name) {
+    std::fprintf(stderr,
+                 "usage: %s [options] input.pcap [output.pcap]\n"
+                 "\n"
+                 "Replays input.pcap into a simulated ENC28J60 and reports\n"
+                 "how the receive path keeps up. Transmitted frames are\n"
+                 "written to output.pcap.\n"
+                 "\n"
+                 "  --rate FPS            offer frames at a fixed rate\n"
+                 "  --speed FACTOR        scale the capture timing (default 1)\n"
+                 "  --spi-frequency HZ    modeled SPI clock (default 20000000)\n"
+                 "  --transaction-ns NS   modeled cost per transaction (default 2000)\n"
+                 "  --filter ERXFCON      receive filter (default 0x00, promiscuous)\n"
+                 "  --macon1 VALUE        override MACON1\n"
+                 "  --macon3 VALUE        override MACON3\n"
+                 "  --echo                transmit every received frame\n",
+                 name);
+}
+
+std::optional<unsigned long> number(const char *text) {
+    char *end = nullptr;
+    const unsigned long value = std::strtoul(text, &end, 0);
+    if (!*text || *end) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+}
+
+int main(int argc, char **argv) {
+    pcap::replay_options options;
+    std::uint8_t receive_filter = 0;
+    std::optional<std::uint8_t> macon1;
+    std::optional<std::uint8_t> macon3;
+    bool echo = false;
+    const char *input = nullptr;
+    const char *output = nullptr;
+    
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : "";
+        
+        if (!std::strcmp(arg, "--echo")) {
+            echo = true;
+            continue;
+        }
+        if (arg[0] != '-' || arg[1] != '-') {
+            if (!input) {
+                input = arg;
+            } else if (!output) {
+                output = arg;
+            } else {
+                usage(argv[0]);
+                return 2;
+            }
+            continue;
+        }
+        
+        ++i;
+        const std::optional<unsigned long> n = number(value);
+        if (!std::strcmp(arg, "--rate") || !std::strcmp(arg, "--speed")) {
+            const double d = std::strtod(value, nullptr);
+            if (d <= 0) {
+                usage(argv[0]);
+                return 2;
+            }
+            (arg[2] == 'r' ? options.rate : options.speed) = d;
+        } else if (!n) {
+            usage(argv[0]);
+            return 2;
+        } else if (!std::strcmp(arg, "--spi-frequency") && *n) {
+            options.spi_frequency = static_cast<std::uint32_t>(*n);
+        } else if (!std::strcmp(arg, "--transaction-ns")) {
+            options.transaction_ns = static_cast<std::uint32_t>(*n);
+        } else if (!std::strcmp(arg, "--filter")) {
+            receive_filter = static_cast<std::uint8_t>(*n);
+        } else if (!std::strcmp(arg, "--macon1")) {
+            macon1 = static_cast<std::uint8_t>(*n);
+        } else if (!std::strcmp(arg, "--macon3")) {
+            macon3 = static_cast<std::uint8_t>(*n);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    
+    if (!input) {
+        usage(argv[0]);
+        return 2;
+    }
+    
+    pcap::reader reader(input);
+    if (!reader.valid()) {
+        std::fprintf(stderr, "%s: not an Ethernet pcap file\n", input);
+        return 1;
+    }
+    
+    std::optional<pcap::writer> writer;
+    if (output) {
+        writer.emplace(output);
+        if (!writer->valid()) {
+            std::fprintf(stderr, "%s: cannot create\n", output);
+            return 1;
+        }
+    }
+    
+    sim::chip chip;
+    device dev(chip);
+    init::play(dev, image);
+    if (macon1) {
+        dev.write(mac::control_register_1(*macon1));
+    }
+    if (macon3) {
+        dev.write(mac::control_register_3(*macon3));
+    }
+    dev.write(eth::receive_filter(receive_filter));
+    
+    rx::ring ring(dev, plan.rx_start, plan.rx_end);
+    ring.init();
+    tx::queue<plan.slots> queue(dev, plan.tx_start, plan.slot_size);
+    queue.init();
+    dev.set_bits(eth::address::econ1,
+                 eth::control_register_1(0).receive(true).data());
+    
+    pcap::replay replay(chip, ring, options);
+    if (writer) {
+        replay.capture(*writer);
+    }
+    if (echo) {
+        replay.on_frame([&queue](const rx::packet &packet) {
+            while (!queue.free_slots()) {
+                queue.poll();
+            }
+            queue.send(packet.data, packet.size);
+        });
+    }
+    
+    const pcap::replay_report &report = replay.run(reader);
+    if (!reader.valid()) {
+        std::fprintf(stderr, "%s: record larger than the snapshot length\n",
+                     input);
+    }
+    while (!queue.idle()) {
+        queue.poll();
+    }
+    
+    std::printf("frames        %llu\n"
+                "received      %llu\n"
+                "filtered      %llu\n"
+                "overflows     %llu\n"
+                "dropped       %llu\n"
+                "transmitted   %llu\n"
+                "errors        %llu\n"
+                "frames/s      %.0f\n"
+                "SPI bytes     %.1f per frame\n"
+                "latency       p50 %.1f us, p99 %.1f us, max %.1f us\n",
+                (unsigned long long)report.frames,
+                (unsigned long long)report.received,
+                (unsigned long long)report.filtered,
+                (unsigned long long)report.overflows,
+                (unsigned long long)report.dropped,
+                (unsigned long long)report.transmitted,
+                (unsigned long long)report.errors,
+                report.frames_per_second(),
+                report.spi_bytes_per_frame(),
+                report.latency_percentile(0.5) / 1e3,
+                report.latency_percentile(0.99) / 1e3,
+                report.latency_percentile(1) / 1e3);
+    return 0;
+}